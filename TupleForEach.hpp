@@ -28,7 +28,7 @@ namespace TupleForEach
 \
 		f(std::get<I>(t), args...); \
 		if constexpr (I < size) \
-			doForEach<I + 1, F, TupleTs..., Args...>(t, std::forward<F>(f), std::forward<Args>(args)...); \
+			doForEach<I + 1>(t, std::forward<F>(f), std::forward<Args>(args)...); \
 	}
 
 		GEN_FOREACH(&)
@@ -40,7 +40,7 @@ namespace TupleForEach
 	template<typename F, typename... TupleTs, typename... Args > \
 	static constexpr void foreach(std::tuple<TupleTs...> mod t, F&& f, Args&&... args) \
 	{ \
-		detail::doForEach<0, F, TupleTs..., Args...>(t, std::forward<F>(f), std::forward<Args>(args)...); \
+		detail::doForEach<0>(t, std::forward<F>(f), std::forward<Args>(args)...); \
 	} \
 
 	GEN_FOREACH_PUBL(&)
@@ -0,0 +1,162 @@
+/*Build then discard cycles of short lived tables, like a table that only lives while one request is handled: every
+ *iteration fills an empty 4 column table with push_back, without reserving, and destroys it. Benchmark names are
+ *<container>_<memory>/<rows>, where memory is
+ *	default:	std::vector columns with std::allocator
+ *	new_delete:	std::pmr::vector columns on std::pmr::new_delete_resource(), the cost of the pmr indirection alone
+ *	pool:		std::pmr::vector columns on a std::pmr::unsynchronized_pool_resource kept between the cycles
+ *	arena:		mvg::pmr::arena_container, released in one go at the end of every cycle
+ *	buffer:		mvg::pmr::arena_container on a preallocated buffer, so the cycles don't allocate at all
+ *multi_vector_* is the same for mvg::multi_vector, which allocates one block for all columns
+*/
+#include "bench_common.hpp"
+
+#include <memory_resource>
+
+#include "multi_vector.hpp"
+#include "pmr_container.hpp"
+
+using namespace bench;
+
+namespace
+{
+
+using row = std::tuple<int, double, float, long long>;
+using default_table = mvg::multi_container<std::vector<int>, std::vector<double>, std::vector<float>, std::vector<long long>>;
+using pmr_table = mvg::pmr::multi_container<int, double, float, long long>;
+using arena_table = mvg::pmr::arena_container<int, double, float, long long>;
+using vector_table = mvg::multi_vector<int, double, float, long long>;
+
+//Per request tables are small, the cycles stop at 1M rows
+constexpr std::size_t max_request_rows = std::min<std::size_t>(1000000, MVG_BENCHMARK_MAX_ROWS);
+
+//Memory needed by the columns of a table of n rows growing by push_back, with room for the discarded smaller blocks
+constexpr std::size_t buffer_bytes(std::size_t n)
+{
+	return 4 * n * (sizeof(int) + sizeof(double) + sizeof(float) + sizeof(long long)) + 4096;
+}
+
+row make_row(std::size_t i)
+{
+	return row(value<int>(i), value<double>(i), value<float>(i), value<long long>(i));
+}
+
+template<typename Table>
+void fill(Table& t, std::size_t n)
+{
+	for (std::size_t i = 0; i < n; ++i)
+	{
+		t.push_back(make_row(i));
+	}
+	benchmark::DoNotOptimize(t.size());
+}
+
+void multi_container_default(benchmark::State& state)
+{
+	std::size_t const n = rows_of(state);
+	for (auto _ : state)
+	{
+		default_table t;
+		fill(t, n);
+	}
+	set_rows_processed(state, n);
+}
+
+void multi_container_new_delete(benchmark::State& state)
+{
+	std::size_t const n = rows_of(state);
+	for (auto _ : state)
+	{
+		pmr_table t(std::pmr::new_delete_resource());
+		fill(t, n);
+	}
+	set_rows_processed(state, n);
+}
+
+void multi_container_pool(benchmark::State& state)
+{
+	std::size_t const n = rows_of(state);
+	std::pmr::unsynchronized_pool_resource pool;
+	for (auto _ : state)
+	{
+		pmr_table t(&pool);
+		fill(t, n);
+	}
+	set_rows_processed(state, n);
+}
+
+void multi_container_arena(benchmark::State& state)
+{
+	std::size_t const n = rows_of(state);
+	arena_table t;
+	for (auto _ : state)
+	{
+		fill(t.container(), n);
+		t.release();
+	}
+	set_rows_processed(state, n);
+}
+
+void multi_container_buffer(benchmark::State& state)
+{
+	std::size_t const n = rows_of(state);
+	std::vector<std::byte> buffer(buffer_bytes(n));
+	arena_table t(buffer.data(), buffer.size());
+	for (auto _ : state)
+	{
+		fill(t.container(), n);
+		t.release();
+	}
+	set_rows_processed(state, n);
+}
+
+void multi_vector_default(benchmark::State& state)
+{
+	std::size_t const n = rows_of(state);
+	for (auto _ : state)
+	{
+		vector_table t;
+		fill(t, n);
+	}
+	set_rows_processed(state, n);
+}
+
+void multi_vector_arena(benchmark::State& state)
+{
+	std::size_t const n = rows_of(state);
+	for (auto _ : state)
+	{
+		std::pmr::monotonic_buffer_resource arena;
+		vector_table t(&arena);
+		fill(t, n);
+	}
+	set_rows_processed(state, n);
+}
+
+void multi_vector_buffer(benchmark::State& state)
+{
+	std::size_t const n = rows_of(state);
+	std::vector<std::byte> buffer(buffer_bytes(n));
+	for (auto _ : state)
+	{
+		std::pmr::monotonic_buffer_resource arena(buffer.data(), buffer.size(), std::pmr::null_memory_resource());
+		vector_table t(&arena);
+		fill(t, n);
+	}
+	set_rows_processed(state, n);
+}
+
+void request_rows(benchmark::internal::Benchmark* b)
+{
+	row_range(b, max_request_rows);
+}
+
+} //namespace
+
+BENCHMARK(multi_container_default)->Apply(request_rows);
+BENCHMARK(multi_container_new_delete)->Apply(request_rows);
+BENCHMARK(multi_container_pool)->Apply(request_rows);
+BENCHMARK(multi_container_arena)->Apply(request_rows);
+BENCHMARK(multi_container_buffer)->Apply(request_rows);
+BENCHMARK(multi_vector_default)->Apply(request_rows);
+BENCHMARK(multi_vector_arena)->Apply(request_rows);
+BENCHMARK(multi_vector_buffer)->Apply(request_rows);
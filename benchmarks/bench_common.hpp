@@ -0,0 +1,193 @@
+#ifndef MVG_BENCH_COMMON_HPP_
+#define MVG_BENCH_COMMON_HPP_
+
+#include <benchmark/benchmark.h>
+
+#include <tuple>
+#include <vector>
+#include <array>
+#include <list>
+#include <memory>
+#include <utility>
+#include <algorithm>
+#include <type_traits>
+#include <iterator>
+#include <cstddef>
+#include <cstdint>
+
+#include "multi_container.hpp"
+
+#ifndef MVG_BENCHMARK_MAX_ROWS
+#define MVG_BENCHMARK_MAX_ROWS 100000000
+#endif
+
+namespace bench
+{
+
+//Element types of the columns, the first N are used by a container with N columns
+using element_types = std::tuple<int, double, float, long long, unsigned, short, std::uint64_t, double>;
+
+template<std::size_t I>
+using element_t = std::tuple_element_t<I, element_types>;
+
+//Values are below value_limit, so they fit into every element type and a row of value_limit is never found
+constexpr std::size_t value_limit = 30011;
+
+template<typename T>
+T value(std::size_t row)
+{
+	return static_cast<T>((row * 2654435761u) % value_limit);
+}
+
+//Element type of a column container
+template<typename C>
+using column_value_t = typename std::iterator_traits<decltype(std::begin(std::declval<C&>()))>::value_type;
+
+template<typename C>
+constexpr bool is_array_v = false;
+
+template<typename T, std::size_t N>
+constexpr bool is_array_v<std::array<T, N>> = true;
+
+template<typename C>
+constexpr bool is_list_v = false;
+
+template<typename T, typename A>
+constexpr bool is_list_v<std::list<T, A>> = true;
+
+template<typename T>
+struct parallel_vectors;
+
+/*\class: mix
+ *\usage: A combination of column containers to benchmark. container is the multi_container over them, baseline the
+ *		  hand written parallel std::vectors with the same element types it is compared with
+*/
+template<typename... Cs>
+struct mix
+{
+	using container = mvg::multi_container<Cs...>;
+	using row = std::tuple<column_value_t<Cs>...>;
+	using baseline = parallel_vectors<row>;
+
+	//Arrays can't change their size
+	static constexpr bool resizable = !(is_array_v<Cs> || ...);
+
+	//List nodes take several times the memory of their element, so lists stop at a tenth of the rows
+	static constexpr std::size_t max_rows = (is_list_v<Cs> || ...) ? MVG_BENCHMARK_MAX_ROWS / 10 : MVG_BENCHMARK_MAX_ROWS;
+
+	static row make_row(std::size_t i)
+	{
+		return row(value<column_value_t<Cs>>(i)...);
+	}
+
+	//Returns a container with n rows. Arrays are sized at compile time and must hold exactly n elements
+	static std::unique_ptr<container> make(std::size_t n)
+	{
+		auto c = std::make_unique<container>();
+		std::apply([n](auto&... cols) { (fill(cols, n), ...); }, c->data());
+		return c;
+	}
+
+private:
+	template<typename C>
+	static void fill(C& cont, std::size_t n)
+	{
+		using T = column_value_t<C>;
+		if constexpr (is_array_v<C>)
+		{
+			for (std::size_t i = 0; i < n; ++i)
+			{
+				cont[i] = value<T>(i);
+			}
+		}
+		else
+		{
+			for (std::size_t i = 0; i < n; ++i)
+			{
+				cont.push_back(value<T>(i));
+			}
+		}
+	}
+};
+
+//Mixes of N columns of the same container template
+template<template<typename...> class C, typename Seq>
+struct uniform_mix_impl;
+
+template<template<typename...> class C, std::size_t... Is>
+struct uniform_mix_impl<C, std::index_sequence<Is...>>
+{
+	using type = mix<C<element_t<Is>>...>;
+};
+
+template<template<typename...> class C, std::size_t N>
+using uniform_mix = typename uniform_mix_impl<C, std::make_index_sequence<N>>::type;
+
+/*\class: parallel_vectors
+ *\usage: Hand written structure of arrays, one std::vector per column indexed by row number, the baseline for multi_container
+*/
+template<typename... Ts>
+struct parallel_vectors<std::tuple<Ts...>>
+{
+	std::tuple<std::vector<Ts>...> columns;
+
+	static parallel_vectors make(std::size_t n)
+	{
+		parallel_vectors p;
+		std::apply([n](auto&... cols)
+		{
+			(cols.reserve(n), ...);
+			for (std::size_t i = 0; i < n; ++i)
+			{
+				(cols.push_back(value<typename std::decay_t<decltype(cols)>::value_type>(i)), ...);
+			}
+		}, p.columns);
+		return p;
+	}
+
+	std::size_t size() const
+	{
+		return std::get<0>(columns).size();
+	}
+};
+
+//Sum of all elements of a row, to keep the compiler from dropping reads
+template<typename Row, std::size_t... Is>
+double row_sum(Row const& row, std::index_sequence<Is...>)
+{
+	return (static_cast<double>(std::get<Is>(row)) + ...);
+}
+
+template<typename Row>
+double row_sum(Row const& row)
+{
+	return row_sum(row, std::make_index_sequence<std::tuple_size_v<std::decay_t<Row>>> {});
+}
+
+//Row counts from 1K rows to max_rows, in steps of 10
+inline void row_range(benchmark::internal::Benchmark* b, std::size_t max_rows)
+{
+	b->RangeMultiplier(10)->Range(1000, static_cast<std::int64_t>(max_rows));
+}
+
+//Row counts from 1K rows to the row limit of Mix, in steps of 10
+template<typename Mix>
+void rows(benchmark::internal::Benchmark* b)
+{
+	row_range(b, Mix::max_rows);
+}
+
+//Row count of benchmarks taking it as their first argument
+inline std::size_t rows_of(benchmark::State const& state)
+{
+	return static_cast<std::size_t>(state.range(0));
+}
+
+inline void set_rows_processed(benchmark::State& state, std::size_t rows_per_iteration)
+{
+	state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(rows_per_iteration));
+}
+
+} //namespace bench
+
+#endif
@@ -0,0 +1,157 @@
+/*Inserting a block of rows in the middle of a container holding as many rows. The range and count overloads of
+ *multi_container::insert forward to the insert of every column, insert_each_multi inserts the same rows one at a time,
+ *which moves the rows after the insert position once per row, and insert_vectors is the native insert of parallel vectors.
+ *Benchmark names are <operation>_<kind><mix>/<rows>, the inserted rows are restored outside of the timed region.
+ *insert_each is quadratic, so it stops at per_element_max_rows rows
+*/
+#include "bench_common.hpp"
+
+#include <deque>
+
+using namespace bench;
+
+using vector4 = uniform_mix<std::vector, 4>;
+using deque4 = uniform_mix<std::deque, 4>;
+
+namespace
+{
+
+constexpr std::size_t per_element_max_rows = 100000;
+
+//Removes the n rows inserted at the middle of a container that held n rows before, outside of the timed region
+template<typename Container>
+void erase_inserted(benchmark::State& state, Container& c, std::size_t n)
+{
+	state.PauseTiming();
+	auto first = std::next(c.begin(), static_cast<std::ptrdiff_t>(n / 2));
+	c.erase(first, std::next(first, static_cast<std::ptrdiff_t>(n)));
+	state.ResumeTiming();
+}
+
+//Range insert from another multi_container
+
+template<typename Mix>
+void insert_range_multi(benchmark::State& state)
+{
+	std::size_t const n = rows_of(state);
+	auto const c = Mix::make(n);
+	auto const source = Mix::make(n);
+	for (auto _ : state)
+	{
+		auto it = c->insert(std::next(c->begin(), static_cast<std::ptrdiff_t>(n / 2)), source->begin(), source->end());
+		benchmark::DoNotOptimize(it);
+		erase_inserted(state, *c, n);
+	}
+	set_rows_processed(state, n);
+}
+
+//Range insert from a tuple of column ranges, here one std::vector per column
+
+template<typename Mix>
+void insert_columns_multi(benchmark::State& state)
+{
+	std::size_t const n = rows_of(state);
+	auto const c = Mix::make(n);
+	auto const source = Mix::baseline::make(n);
+	auto const firsts = std::apply([](auto const&... cols) { return std::make_tuple(cols.begin()...); }, source.columns);
+	auto const lasts = std::apply([](auto const&... cols) { return std::make_tuple(cols.end()...); }, source.columns);
+	for (auto _ : state)
+	{
+		auto it = c->insert(std::next(c->begin(), static_cast<std::ptrdiff_t>(n / 2)), firsts, lasts);
+		benchmark::DoNotOptimize(it);
+		erase_inserted(state, *c, n);
+	}
+	set_rows_processed(state, n);
+}
+
+//n copies of one row
+
+template<typename Mix>
+void insert_count_multi(benchmark::State& state)
+{
+	std::size_t const n = rows_of(state);
+	auto const c = Mix::make(n);
+	auto const row = Mix::make_row(0);
+	for (auto _ : state)
+	{
+		auto it = c->insert(std::next(c->begin(), static_cast<std::ptrdiff_t>(n / 2)), n, row);
+		benchmark::DoNotOptimize(it);
+		erase_inserted(state, *c, n);
+	}
+	set_rows_processed(state, n);
+}
+
+//The same rows as insert_range_multi, inserted one at a time
+
+template<typename Mix>
+void insert_each_multi(benchmark::State& state)
+{
+	std::size_t const n = rows_of(state);
+	auto const c = Mix::make(n);
+	std::vector<typename Mix::row> source;
+	for (std::size_t i = 0; i < n; ++i)
+	{
+		source.push_back(Mix::make_row(i));
+	}
+	for (auto _ : state)
+	{
+		auto it = std::next(c->begin(), static_cast<std::ptrdiff_t>(n / 2));
+		for (auto const& row : source)
+		{
+			it = c->insert(it, row);
+			++it;
+		}
+		benchmark::DoNotOptimize(it);
+		erase_inserted(state, *c, n);
+	}
+	set_rows_processed(state, n);
+}
+
+template<typename Mix>
+void insert_vectors(benchmark::State& state)
+{
+	std::size_t const n = rows_of(state);
+	auto p = Mix::baseline::make(n);
+	auto const source = Mix::baseline::make(n);
+	auto const middle = static_cast<std::ptrdiff_t>(n / 2);
+	for (auto _ : state)
+	{
+		std::apply([&source, middle](auto&... cols)
+		{
+			std::apply([&cols..., middle](auto const&... source_cols)
+			{
+				(cols.insert(cols.begin() + middle, source_cols.begin(), source_cols.end()), ...);
+			}, source.columns);
+		}, p.columns);
+		benchmark::DoNotOptimize(p.columns);
+		state.PauseTiming();
+		std::apply([n, middle](auto&... cols) { (cols.erase(cols.begin() + middle, cols.begin() + middle + static_cast<std::ptrdiff_t>(n)), ...); }, p.columns);
+		state.ResumeTiming();
+	}
+	set_rows_processed(state, n);
+}
+
+//Containers grow to twice the row count while the rows are inserted
+template<typename Mix>
+void bulk_rows(benchmark::internal::Benchmark* b)
+{
+	row_range(b, Mix::max_rows / 2);
+}
+
+template<typename Mix>
+void per_element_rows(benchmark::internal::Benchmark* b)
+{
+	row_range(b, std::min(Mix::max_rows / 2, per_element_max_rows));
+}
+
+} //namespace
+
+#define MVG_BENCHMARK_BULK_INSERT(Mix) \
+	BENCHMARK_TEMPLATE(insert_range_multi, Mix)->Apply(bulk_rows<Mix>); \
+	BENCHMARK_TEMPLATE(insert_columns_multi, Mix)->Apply(bulk_rows<Mix>); \
+	BENCHMARK_TEMPLATE(insert_count_multi, Mix)->Apply(bulk_rows<Mix>); \
+	BENCHMARK_TEMPLATE(insert_each_multi, Mix)->Apply(per_element_rows<Mix>); \
+	BENCHMARK_TEMPLATE(insert_vectors, Mix)->Apply(bulk_rows<Mix>)
+
+MVG_BENCHMARK_BULK_INSERT(vector4);
+MVG_BENCHMARK_BULK_INSERT(deque4);
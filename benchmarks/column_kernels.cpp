@@ -0,0 +1,186 @@
+/*The column kernels of multi_container next to the plain range-for loop over the rows computing the same result.
+ *Benchmark names are <kernel>_<kind>/<rows>, where kind is kernel for the built in kernel, batch for a loop over
+ *for_each_batch<16> spans and loop for the range-for loop. The table has an int, a float and a double column,
+ *and a byte (masked_select_*<3>) and an int (masked_select_*<4>) mask column, each set in about every other row in a pseudo
+ *random pattern. Configure with -DMVG_BENCHMARK_NATIVE=ON to let the kernels use AVX2 where the machine has it
+*/
+#include "bench_common.hpp"
+
+#include "column_kernels.hpp"
+
+using namespace bench;
+
+namespace
+{
+
+using table = mvg::multi_container<std::vector<int>, std::vector<float>, std::vector<double>, std::vector<std::uint8_t>, std::vector<int>>;
+
+std::unique_ptr<table> make_table(std::size_t n)
+{
+	auto t = std::make_unique<table>();
+	for (std::size_t i = 0; i < n; ++i)
+	{
+		int const selected = static_cast<int>((i * 2654435761u >> 7) & 1);
+		t->push_back(std::make_tuple(value<int>(i), value<float>(i), value<double>(i), static_cast<std::uint8_t>(selected), selected));
+	}
+	return t;
+}
+
+//Sum of the float column
+
+void sum_kernel(benchmark::State& state)
+{
+	auto const t = make_table(rows_of(state));
+	for (auto _ : state)
+	{
+		benchmark::DoNotOptimize(t->sum<1>());
+	}
+	set_rows_processed(state, rows_of(state));
+}
+
+void sum_batch(benchmark::State& state)
+{
+	auto const t = make_table(rows_of(state));
+	for (auto _ : state)
+	{
+		float sum = 0;
+		t->for_each_batch<16>([&sum](auto, auto f, auto, auto, auto)
+		{
+			float batch = 0;
+			for (std::size_t i = 0; i < f.size(); ++i)
+			{
+				batch += f[i];
+			}
+			sum += batch;
+		});
+		benchmark::DoNotOptimize(sum);
+	}
+	set_rows_processed(state, rows_of(state));
+}
+
+void sum_loop(benchmark::State& state)
+{
+	auto const t = make_table(rows_of(state));
+	for (auto _ : state)
+	{
+		float sum = 0;
+		for (auto const& row : *t)
+		{
+			sum += std::get<1>(row);
+		}
+		benchmark::DoNotOptimize(sum);
+	}
+	set_rows_processed(state, rows_of(state));
+}
+
+//Smallest and largest value of the int column
+
+void min_max_kernel(benchmark::State& state)
+{
+	auto const t = make_table(rows_of(state));
+	for (auto _ : state)
+	{
+		benchmark::DoNotOptimize(t->min_max<0>());
+	}
+	set_rows_processed(state, rows_of(state));
+}
+
+void min_max_loop(benchmark::State& state)
+{
+	auto const t = make_table(rows_of(state));
+	for (auto _ : state)
+	{
+		int lo = std::get<0>(t->front());
+		int hi = lo;
+		for (auto const& row : *t)
+		{
+			lo = std::min(lo, std::get<0>(row));
+			hi = std::max(hi, std::get<0>(row));
+		}
+		benchmark::DoNotOptimize(lo);
+		benchmark::DoNotOptimize(hi);
+	}
+	set_rows_processed(state, rows_of(state));
+}
+
+//Dot product of the float and the double column
+
+void dot_kernel(benchmark::State& state)
+{
+	auto const t = make_table(rows_of(state));
+	for (auto _ : state)
+	{
+		benchmark::DoNotOptimize(t->dot<1, 2>());
+	}
+	set_rows_processed(state, rows_of(state));
+}
+
+void dot_loop(benchmark::State& state)
+{
+	auto const t = make_table(rows_of(state));
+	for (auto _ : state)
+	{
+		double dot = 0;
+		for (auto const& row : *t)
+		{
+			dot += static_cast<double>(std::get<1>(row)) * std::get<2>(row);
+		}
+		benchmark::DoNotOptimize(dot);
+	}
+	set_rows_processed(state, rows_of(state));
+}
+
+//Doubles of the rows whose mask is set, with a byte mask and an int mask
+
+template<std::size_t M>
+void masked_select_kernel(benchmark::State& state)
+{
+	auto const t = make_table(rows_of(state));
+	std::vector<double> out(rows_of(state));
+	for (auto _ : state)
+	{
+		auto last = t->masked_select<2, M>(out.begin());
+		benchmark::DoNotOptimize(last);
+	}
+	set_rows_processed(state, rows_of(state));
+}
+
+template<std::size_t M>
+void masked_select_loop(benchmark::State& state)
+{
+	auto const t = make_table(rows_of(state));
+	std::vector<double> out(rows_of(state));
+	for (auto _ : state)
+	{
+		auto last = out.begin();
+		for (auto const& row : *t)
+		{
+			if (std::get<M>(row))
+			{
+				*last = std::get<2>(row);
+				++last;
+			}
+		}
+		benchmark::DoNotOptimize(last);
+	}
+	set_rows_processed(state, rows_of(state));
+}
+
+void table_rows(benchmark::internal::Benchmark* b)
+{
+	row_range(b, MVG_BENCHMARK_MAX_ROWS);
+}
+
+} //namespace
+
+BENCHMARK(sum_kernel)->Apply(table_rows);
+BENCHMARK(sum_batch)->Apply(table_rows);
+BENCHMARK(sum_loop)->Apply(table_rows);
+BENCHMARK(min_max_kernel)->Apply(table_rows);
+BENCHMARK(min_max_loop)->Apply(table_rows);
+BENCHMARK(dot_kernel)->Apply(table_rows);
+BENCHMARK(dot_loop)->Apply(table_rows);
+BENCHMARK_TEMPLATE(masked_select_kernel, 3)->Apply(table_rows);
+BENCHMARK_TEMPLATE(masked_select_loop, 3)->Apply(table_rows);
+BENCHMARK_TEMPLATE(masked_select_kernel, 4)->Apply(table_rows);
+BENCHMARK_TEMPLATE(masked_select_loop, 4)->Apply(table_rows);
@@ -0,0 +1,201 @@
+/*Append and scan throughput of mvg::concurrent_container, next to the same work over parallel std::vectors, which can't be
+ *read while they are appended to. append_with_readers/<readers>/<rows> appends while reader threads keep scanning,
+ *and reports the rows the readers got through as scanned_rows
+*/
+#include "bench_common.hpp"
+
+#include <atomic>
+#include <thread>
+
+#include "concurrent_container.hpp"
+
+using namespace bench;
+
+namespace
+{
+
+using row = std::tuple<std::int64_t, double, float, std::uint32_t>;
+using table = mvg::concurrent_container<std::int64_t, double, float, std::uint32_t>;
+using vectors = parallel_vectors<row>;
+
+row make_row(std::size_t i)
+{
+	return row(value<std::int64_t>(i), value<double>(i), value<float>(i), value<std::uint32_t>(i));
+}
+
+std::unique_ptr<table> make_table(std::size_t n)
+{
+	auto t = std::make_unique<table>();
+	for (std::size_t i = 0; i < n; ++i)
+	{
+		t->push_back(make_row(i));
+	}
+	return t;
+}
+
+double segment_sum(table const& t)
+{
+	double sum = 0;
+	t.for_each_segment([&sum](std::size_t count, std::int64_t const* a, double const* b, float const* c, std::uint32_t const* d)
+	{
+		for (std::size_t i = 0; i < count; ++i)
+		{
+			sum += static_cast<double>(a[i]) + b[i] + static_cast<double>(c[i]) + static_cast<double>(d[i]);
+		}
+	});
+	return sum;
+}
+
+//Appending rows to an empty container
+
+void append_concurrent(benchmark::State& state)
+{
+	std::size_t const n = rows_of(state);
+	for (auto _ : state)
+	{
+		table t;
+		for (std::size_t i = 0; i < n; ++i)
+		{
+			t.push_back(make_row(i));
+		}
+		benchmark::DoNotOptimize(t.size());
+	}
+	set_rows_processed(state, n);
+}
+
+void append_vectors(benchmark::State& state)
+{
+	std::size_t const n = rows_of(state);
+	for (auto _ : state)
+	{
+		vectors p;
+		for (std::size_t i = 0; i < n; ++i)
+		{
+			auto const r = make_row(i);
+			std::apply([&r](auto&... cols)
+			{
+				std::apply([&cols...](auto const&... elems) { (cols.push_back(elems), ...); }, r);
+			}, p.columns);
+		}
+		benchmark::DoNotOptimize(p.columns);
+	}
+	set_rows_processed(state, n);
+}
+
+//Summing all rows, one segment at a time, through the row iterators, and over the vectors
+
+void scan_segments(benchmark::State& state)
+{
+	auto const t = make_table(rows_of(state));
+	for (auto _ : state)
+	{
+		benchmark::DoNotOptimize(segment_sum(*t));
+	}
+	set_rows_processed(state, rows_of(state));
+}
+
+void scan_iterator(benchmark::State& state)
+{
+	auto const t = make_table(rows_of(state));
+	for (auto _ : state)
+	{
+		double sum = 0;
+		for (auto const& r : t->snapshot())
+		{
+			sum += row_sum(r);
+		}
+		benchmark::DoNotOptimize(sum);
+	}
+	set_rows_processed(state, rows_of(state));
+}
+
+void scan_vectors(benchmark::State& state)
+{
+	auto const p = vectors::make(rows_of(state));
+	auto const& [a, b, c, d] = p.columns;
+	std::size_t const n = p.size();
+	for (auto _ : state)
+	{
+		double sum = 0;
+		for (std::size_t i = 0; i < n; ++i)
+		{
+			sum += static_cast<double>(a[i]) + b[i] + static_cast<double>(c[i]) + static_cast<double>(d[i]);
+		}
+		benchmark::DoNotOptimize(sum);
+	}
+	set_rows_processed(state, n);
+}
+
+//Appending while reader threads scan the published rows with for_each_segment() in a loop
+
+void append_with_readers(benchmark::State& state)
+{
+	auto const readers = static_cast<std::size_t>(state.range(0));
+	auto const n = static_cast<std::size_t>(state.range(1));
+	std::size_t scanned = 0;
+	for (auto _ : state)
+	{
+		state.PauseTiming();
+		table t;
+		std::atomic<bool> done { false };
+		std::atomic<std::size_t> reader_rows { 0 };
+		std::vector<std::thread> threads;
+		for (std::size_t r = 0; r < readers; ++r)
+		{
+			threads.emplace_back([&t, &done, &reader_rows]
+			{
+				std::size_t rows = 0;
+				while (!done.load(std::memory_order_acquire))
+				{
+					std::size_t const published = t.size();
+					double const sum = segment_sum(t);
+					benchmark::DoNotOptimize(sum);
+					rows += published;
+				}
+				reader_rows.fetch_add(rows, std::memory_order_relaxed);
+			});
+		}
+		state.ResumeTiming();
+
+		for (std::size_t i = 0; i < n; ++i)
+		{
+			t.push_back(make_row(i));
+		}
+
+		state.PauseTiming();
+		done.store(true, std::memory_order_release);
+		for (std::thread& thread : threads)
+		{
+			thread.join();
+		}
+		scanned += reader_rows.load(std::memory_order_relaxed);
+		state.ResumeTiming();
+	}
+	set_rows_processed(state, n);
+	state.counters["scanned_rows"] = benchmark::Counter(static_cast<double>(scanned), benchmark::Counter::kIsRate);
+}
+
+void table_rows(benchmark::internal::Benchmark* b)
+{
+	row_range(b, MVG_BENCHMARK_MAX_ROWS);
+}
+
+void readers_and_rows(benchmark::internal::Benchmark* b)
+{
+	for (std::int64_t readers : { 1, 2, 4 })
+	{
+		for (std::int64_t n = 1000; n <= MVG_BENCHMARK_MAX_ROWS; n *= 10)
+		{
+			b->Args({ readers, n });
+		}
+	}
+}
+
+} //namespace
+
+BENCHMARK(append_concurrent)->Apply(table_rows);
+BENCHMARK(append_vectors)->Apply(table_rows);
+BENCHMARK(scan_segments)->Apply(table_rows);
+BENCHMARK(scan_iterator)->Apply(table_rows);
+BENCHMARK(scan_vectors)->Apply(table_rows);
+BENCHMARK(append_with_readers)->Apply(readers_and_rows)->UseRealTime();
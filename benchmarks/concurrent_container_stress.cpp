@@ -0,0 +1,187 @@
+/*Stress test of mvg::concurrent_container: one writer thread appends rows while reader threads keep scanning them with
+ *every reader interface. Every row holds its own index in several forms, so a reader that sees a row before it is fully
+ *written finds a mismatch. Build with -DMVG_STRESS_TSAN=ON to run it under ThreadSanitizer, which also reports races
+ *that happen to produce the right values.
+ *
+ *Usage: concurrent_container_stress [rows] [readers]
+*/
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "concurrent_container.hpp"
+
+namespace
+{
+
+using table = mvg::concurrent_container<std::uint64_t, double, std::uint32_t, std::string>;
+
+std::uint32_t check_value(std::uint64_t i)
+{
+	return static_cast<std::uint32_t>(i * 2654435761u);
+}
+
+//The string column allocates, so a row that is published before its constructor finished is caught as well
+std::string name_of(std::uint64_t i)
+{
+	return "row " + std::to_string(i);
+}
+
+bool row_ok(std::uint64_t i, std::uint64_t id, double half, std::uint32_t check, std::string const& name)
+{
+	return id == i && half == static_cast<double>(i) * 0.5 && check == check_value(i) && (i % 64 == 0 ? name == name_of(i) : name.empty());
+}
+
+struct reader_stats
+{
+	std::size_t scans = 0;
+	std::size_t rows = 0;
+	std::size_t last_rows = 0;
+	std::size_t errors = 0;
+};
+
+void report(std::size_t& errors, char const* what, std::size_t index)
+{
+	if (errors++ < 10)
+	{
+		std::fprintf(stderr, "%s at row %zu\n", what, index);
+	}
+}
+
+//Reads everything published so far once with every reader interface, and checks that no row is torn
+void scan(table const& t, std::size_t& last_size, reader_stats& stats)
+{
+	std::size_t const size = t.size();
+	if (size < last_size)
+	{
+		report(stats.errors, "size() went back", size);
+	}
+	last_size = size;
+
+	auto const rows = t.snapshot();
+	if (rows.size() < size)
+	{
+		report(stats.errors, "snapshot() is smaller than an earlier size()", rows.size());
+	}
+	std::uint64_t i = 0;
+	for (auto const& row : rows)
+	{
+		if (!row_ok(i, row.get<0>(), row.get<1>(), row.get<2>(), row.get<3>()))
+		{
+			report(stats.errors, "snapshot() row is torn", i);
+		}
+		++i;
+	}
+
+	std::size_t segment_rows = 0;
+	t.for_each_segment([&](std::size_t count, std::uint64_t const* ids, double const* halves, std::uint32_t const* checks,
+		std::string const* names)
+	{
+		for (std::size_t j = 0; j < count; ++j)
+		{
+			if (!row_ok(segment_rows + j, ids[j], halves[j], checks[j], names[j]))
+			{
+				report(stats.errors, "for_each_segment() row is torn", segment_rows + j);
+			}
+		}
+		segment_rows += count;
+	});
+	if (segment_rows < rows.size())
+	{
+		report(stats.errors, "for_each_segment() reached fewer rows than snapshot()", segment_rows);
+	}
+
+	if (!t.empty())
+	{
+		std::size_t const n = t.size();
+		auto const check_row = [&](std::size_t index, auto const& row)
+		{
+			if (!row_ok(index, row.template get<0>(), row.template get<1>(), row.template get<2>(), row.template get<3>()))
+			{
+				report(stats.errors, "operator[] row is torn", index);
+			}
+		};
+		check_row(0, t.front());
+		check_row(n - 1, t[n - 1]);
+		check_row(n / 2, t.at(n / 2));
+		auto const last = t.back();
+		if (last.get<0>() + 1 < n)
+		{
+			report(stats.errors, "back() is older than an earlier size()", static_cast<std::size_t>(last.get<0>()));
+		}
+	}
+
+	++stats.scans;
+	stats.rows += rows.size();
+	stats.last_rows = rows.size();
+}
+
+} //namespace
+
+int main(int argc, char** argv)
+{
+	std::size_t const rows = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 1 << 20;
+	std::size_t const readers = argc > 2 ? std::strtoull(argv[2], nullptr, 10) : 4;
+
+	table t;
+	std::atomic<bool> done { false };
+	std::vector<reader_stats> stats(readers);
+	std::vector<std::thread> threads;
+	for (std::size_t r = 0; r < readers; ++r)
+	{
+		threads.emplace_back([&t, &done, &stats = stats[r]]
+		{
+			std::size_t last_size = 0;
+			while (!done.load(std::memory_order_acquire))
+			{
+				scan(t, last_size, stats);
+			}
+			//One more scan once every row is published
+			scan(t, last_size, stats);
+		});
+	}
+
+	for (std::uint64_t i = 0; i < rows; ++i)
+	{
+		if (i % 64 == 0)
+		{
+			t.emplace_back(std::forward_as_tuple(i), std::forward_as_tuple(static_cast<double>(i) * 0.5),
+				std::forward_as_tuple(check_value(i)), std::forward_as_tuple(name_of(i)));
+		}
+		else
+		{
+			t.push_back(std::make_tuple(i, static_cast<double>(i) * 0.5, check_value(i), std::string {}));
+		}
+	}
+	done.store(true, std::memory_order_release);
+
+	for (std::thread& thread : threads)
+	{
+		thread.join();
+	}
+
+	std::size_t errors = 0;
+	for (std::size_t r = 0; r < readers; ++r)
+	{
+		std::printf("reader %zu: %zu scans, %zu rows read\n", r, stats[r].scans, stats[r].rows);
+		errors += stats[r].errors;
+		if (stats[r].last_rows != rows)
+		{
+			std::fprintf(stderr, "reader %zu missed rows in its last scan\n", r);
+			++errors;
+		}
+	}
+	if (t.size() != rows)
+	{
+		std::fprintf(stderr, "size() is %zu instead of %zu\n", t.size(), rows);
+		++errors;
+	}
+
+	std::printf("%zu rows, %zu readers, %zu errors\n", rows, readers, errors);
+	return errors == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+}
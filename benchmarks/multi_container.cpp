@@ -0,0 +1,447 @@
+/*Benchmarks of the basic multi_container operations over several mixes of column containers, each next to the same
+ *operation written by hand over parallel std::vectors. Benchmark names are <operation>_<kind><mix>/<rows>, where kind is
+ *multi for mvg::multi_container and vectors for the parallel vectors baseline
+*/
+#include "bench_common.hpp"
+
+#include <deque>
+#include <numeric>
+
+using namespace bench;
+
+using vector1 = uniform_mix<std::vector, 1>;
+using vector2 = uniform_mix<std::vector, 2>;
+using vector4 = uniform_mix<std::vector, 4>;
+using vector8 = uniform_mix<std::vector, 8>;
+using deque4 = uniform_mix<std::deque, 4>;
+using list4 = uniform_mix<std::list, 4>;
+using mixed4 = mix<std::vector<int>, std::deque<double>, std::list<float>, std::vector<long long>>;
+
+//Arrays are sized at compile time, so their mixes only run with as many rows as the arrays hold
+template<std::size_t N>
+using array4 = mix<std::array<int, N>, std::vector<double>, std::array<float, N>, std::vector<long long>>;
+
+using array4_1k = array4<1024>;
+using array4_64k = array4<65536>;
+using array4_1m = array4<1048576>;
+
+namespace
+{
+
+//Row indices in a fixed pseudo random order, at most 1M of them
+std::vector<std::size_t> random_indices(std::size_t n)
+{
+	std::vector<std::size_t> indices(std::min<std::size_t>(n, 1 << 20));
+	for (std::size_t i = 0; i < indices.size(); ++i)
+	{
+		indices[i] = (i * 2654435761u) % n;
+	}
+	return indices;
+}
+
+bool first_is_odd(int key)
+{
+	return key % 2 != 0;
+}
+
+//Iterating all rows
+
+template<typename Mix>
+void iterate_multi(benchmark::State& state)
+{
+	auto const c = Mix::make(rows_of(state));
+	for (auto _ : state)
+	{
+		double sum = 0;
+		for (auto const& row : *c)
+		{
+			sum += row_sum(row);
+		}
+		benchmark::DoNotOptimize(sum);
+	}
+	set_rows_processed(state, rows_of(state));
+}
+
+template<typename Mix>
+void iterate_vectors(benchmark::State& state)
+{
+	auto const p = Mix::baseline::make(rows_of(state));
+	std::size_t const n = p.size();
+	for (auto _ : state)
+	{
+		double sum = 0;
+		for (std::size_t i = 0; i < n; ++i)
+		{
+			std::apply([&sum, i](auto const&... cols) { sum += (static_cast<double>(cols[i]) + ...); }, p.columns);
+		}
+		benchmark::DoNotOptimize(sum);
+	}
+	set_rows_processed(state, n);
+}
+
+//Random access with operator[]
+
+template<typename Mix>
+void index_multi(benchmark::State& state)
+{
+	auto const c = Mix::make(rows_of(state));
+	auto const indices = random_indices(rows_of(state));
+	for (auto _ : state)
+	{
+		double sum = 0;
+		for (std::size_t i : indices)
+		{
+			sum += row_sum((*c)[i]);
+		}
+		benchmark::DoNotOptimize(sum);
+	}
+	set_rows_processed(state, indices.size());
+}
+
+template<typename Mix>
+void index_vectors(benchmark::State& state)
+{
+	auto const p = Mix::baseline::make(rows_of(state));
+	auto const indices = random_indices(rows_of(state));
+	for (auto _ : state)
+	{
+		double sum = 0;
+		for (std::size_t i : indices)
+		{
+			std::apply([&sum, i](auto const&... cols) { sum += (static_cast<double>(cols[i]) + ...); }, p.columns);
+		}
+		benchmark::DoNotOptimize(sum);
+	}
+	set_rows_processed(state, indices.size());
+}
+
+//size(), which checks every column unless MVG_CACHE_SIZE is set
+
+template<typename Mix>
+void size_multi(benchmark::State& state)
+{
+	auto const c = Mix::make(rows_of(state));
+	for (auto _ : state)
+	{
+		benchmark::DoNotOptimize(c.get());
+		benchmark::DoNotOptimize(c->size());
+	}
+}
+
+template<typename Mix>
+void size_vectors(benchmark::State& state)
+{
+	auto const p = Mix::baseline::make(rows_of(state));
+	for (auto _ : state)
+	{
+		benchmark::DoNotOptimize(&p);
+		benchmark::DoNotOptimize(p.size());
+	}
+}
+
+//Building a container with push_back, without reserving
+
+template<typename Mix>
+void push_back_multi(benchmark::State& state)
+{
+	std::size_t const n = rows_of(state);
+	for (auto _ : state)
+	{
+		typename Mix::container c;
+		for (std::size_t i = 0; i < n; ++i)
+		{
+			c.push_back(Mix::make_row(i));
+		}
+		benchmark::DoNotOptimize(c.data());
+	}
+	set_rows_processed(state, n);
+}
+
+template<typename Mix>
+void push_back_vectors(benchmark::State& state)
+{
+	std::size_t const n = rows_of(state);
+	for (auto _ : state)
+	{
+		typename Mix::baseline p;
+		for (std::size_t i = 0; i < n; ++i)
+		{
+			auto const row = Mix::make_row(i);
+			std::apply([&row](auto&... cols)
+			{
+				std::apply([&cols...](auto const&... elems) { (cols.push_back(elems), ...); }, row);
+			}, p.columns);
+		}
+		benchmark::DoNotOptimize(p.columns);
+	}
+	set_rows_processed(state, n);
+}
+
+//Inserting a single row in the middle. The row is erased again outside of the timed region
+
+template<typename Mix>
+void insert_multi(benchmark::State& state)
+{
+	auto const c = Mix::make(rows_of(state));
+	auto const row = Mix::make_row(0);
+	auto const middle = static_cast<std::ptrdiff_t>(rows_of(state) / 2);
+	for (auto _ : state)
+	{
+		auto it = c->insert(std::next(c->begin(), middle), row);
+		benchmark::DoNotOptimize(it);
+		state.PauseTiming();
+		c->erase(it);
+		state.ResumeTiming();
+	}
+}
+
+template<typename Mix>
+void insert_vectors(benchmark::State& state)
+{
+	auto p = Mix::baseline::make(rows_of(state));
+	auto const row = Mix::make_row(0);
+	auto const middle = static_cast<std::ptrdiff_t>(rows_of(state) / 2);
+	for (auto _ : state)
+	{
+		std::apply([&row, middle](auto&... cols)
+		{
+			std::apply([&cols..., middle](auto const&... elems) { (cols.insert(cols.begin() + middle, elems), ...); }, row);
+		}, p.columns);
+		benchmark::DoNotOptimize(p.columns);
+		state.PauseTiming();
+		std::apply([middle](auto&... cols) { (cols.erase(cols.begin() + middle), ...); }, p.columns);
+		state.ResumeTiming();
+	}
+}
+
+//Erasing the middle half of the rows with one range erase. The rows are restored outside of the timed region
+
+template<typename Mix>
+void erase_range_multi(benchmark::State& state)
+{
+	std::size_t const n = rows_of(state);
+	auto const original = Mix::make(n);
+	auto const c = Mix::make(n);
+	for (auto _ : state)
+	{
+		auto first = std::next(c->begin(), static_cast<std::ptrdiff_t>(n / 4));
+		auto last = std::next(first, static_cast<std::ptrdiff_t>(n / 2));
+		benchmark::DoNotOptimize(c->erase(first, last));
+		state.PauseTiming();
+		*c = *original;
+		state.ResumeTiming();
+	}
+	set_rows_processed(state, n / 2);
+}
+
+template<typename Mix>
+void erase_range_vectors(benchmark::State& state)
+{
+	std::size_t const n = rows_of(state);
+	auto const original = Mix::baseline::make(n);
+	auto p = original;
+	for (auto _ : state)
+	{
+		std::apply([n](auto&... cols)
+		{
+			(cols.erase(cols.begin() + static_cast<std::ptrdiff_t>(n / 4), cols.begin() + static_cast<std::ptrdiff_t>(n / 4 + n / 2)), ...);
+		}, p.columns);
+		benchmark::DoNotOptimize(p.columns);
+		state.PauseTiming();
+		p = original;
+		state.ResumeTiming();
+	}
+	set_rows_processed(state, n / 2);
+}
+
+//std::sort by the first column. The baseline sorts a permutation of the row numbers and gathers every column through it
+
+template<typename Mix>
+void sort_multi(benchmark::State& state)
+{
+	std::size_t const n = rows_of(state);
+	auto const original = Mix::make(n);
+	auto const c = Mix::make(n);
+	for (auto _ : state)
+	{
+		std::sort(c->begin(), c->end(), [](auto const& a, auto const& b) { return std::get<0>(a) < std::get<0>(b); });
+		benchmark::DoNotOptimize(c->data());
+		state.PauseTiming();
+		*c = *original;
+		state.ResumeTiming();
+	}
+	set_rows_processed(state, n);
+}
+
+template<typename Mix>
+void sort_vectors(benchmark::State& state)
+{
+	std::size_t const n = rows_of(state);
+	auto const original = Mix::baseline::make(n);
+	auto p = original;
+	std::vector<std::size_t> perm(n);
+	for (auto _ : state)
+	{
+		auto const& keys = std::get<0>(p.columns);
+		std::iota(perm.begin(), perm.end(), std::size_t(0));
+		std::sort(perm.begin(), perm.end(), [&keys](std::size_t a, std::size_t b) { return keys[a] < keys[b]; });
+		std::apply([&perm](auto&... cols)
+		{
+			auto gather = [&perm](auto& col)
+			{
+				std::remove_reference_t<decltype(col)> sorted(col.size());
+				for (std::size_t i = 0; i < perm.size(); ++i)
+				{
+					sorted[i] = col[perm[i]];
+				}
+				col.swap(sorted);
+			};
+			(gather(cols), ...);
+		}, p.columns);
+		benchmark::DoNotOptimize(p.columns);
+		state.PauseTiming();
+		p = original;
+		state.ResumeTiming();
+	}
+	set_rows_processed(state, n);
+}
+
+//std::find for a row that is not in the container, so every row is compared
+
+template<typename Mix>
+void find_multi(benchmark::State& state)
+{
+	auto const c = Mix::make(rows_of(state));
+	auto const missing = Mix::make_row(0);
+	auto const target = std::apply([](auto... elems) { return std::make_tuple(decltype(elems)(value_limit)...); }, missing);
+	for (auto _ : state)
+	{
+		benchmark::DoNotOptimize(std::find(c->begin(), c->end(), target));
+	}
+	set_rows_processed(state, rows_of(state));
+}
+
+template<typename Mix>
+void find_vectors(benchmark::State& state)
+{
+	auto const p = Mix::baseline::make(rows_of(state));
+	auto const missing = Mix::make_row(0);
+	auto const target = std::apply([](auto... elems) { return std::make_tuple(decltype(elems)(value_limit)...); }, missing);
+	std::size_t const n = p.size();
+	for (auto _ : state)
+	{
+		std::size_t i = 0;
+		for (; i < n; ++i)
+		{
+			bool const equal = std::apply([&p, i](auto const&... elems)
+			{
+				return std::apply([&, i](auto const&... cols) { return ((cols[i] == elems) && ...); }, p.columns);
+			}, target);
+			if (equal)
+			{
+				break;
+			}
+		}
+		benchmark::DoNotOptimize(i);
+	}
+	set_rows_processed(state, n);
+}
+
+//std::remove_if and erase of the rows with an odd first element. The rows are restored outside of the timed region
+
+template<typename Mix>
+void remove_if_multi(benchmark::State& state)
+{
+	std::size_t const n = rows_of(state);
+	auto const original = Mix::make(n);
+	auto const c = Mix::make(n);
+	for (auto _ : state)
+	{
+		auto last = std::remove_if(c->begin(), c->end(), [](auto const& row) { return first_is_odd(std::get<0>(row)); });
+		c->erase(last, c->end());
+		benchmark::DoNotOptimize(c->data());
+		state.PauseTiming();
+		*c = *original;
+		state.ResumeTiming();
+	}
+	set_rows_processed(state, n);
+}
+
+template<typename Mix>
+void remove_if_vectors(benchmark::State& state)
+{
+	std::size_t const n = rows_of(state);
+	auto const original = Mix::baseline::make(n);
+	auto p = original;
+	for (auto _ : state)
+	{
+		auto const& keys = std::get<0>(p.columns);
+		std::size_t out = 0;
+		for (std::size_t i = 0; i < n; ++i)
+		{
+			if (!first_is_odd(keys[i]))
+			{
+				std::apply([out, i](auto&... cols) { ((cols[out] = std::move(cols[i])), ...); }, p.columns);
+				++out;
+			}
+		}
+		std::apply([out](auto&... cols) { (cols.resize(out), ...); }, p.columns);
+		benchmark::DoNotOptimize(p.columns);
+		state.PauseTiming();
+		p = original;
+		state.ResumeTiming();
+	}
+	set_rows_processed(state, n);
+}
+
+} //namespace
+
+#define MVG_BENCHMARK_PAIR(op, Mix, ...) \
+	BENCHMARK_TEMPLATE(op##_multi, Mix)->__VA_ARGS__; \
+	BENCHMARK_TEMPLATE(op##_vectors, Mix)->__VA_ARGS__
+
+//Operations every mix supports
+#define MVG_BENCHMARK_READ(Mix, ...) \
+	MVG_BENCHMARK_PAIR(iterate, Mix, __VA_ARGS__); \
+	MVG_BENCHMARK_PAIR(size, Mix, __VA_ARGS__); \
+	MVG_BENCHMARK_PAIR(find, Mix, __VA_ARGS__)
+
+//Operations that need random access iterators
+#define MVG_BENCHMARK_RANDOM_ACCESS(Mix, ...) \
+	MVG_BENCHMARK_PAIR(index, Mix, __VA_ARGS__); \
+	MVG_BENCHMARK_PAIR(sort, Mix, __VA_ARGS__)
+
+//Operations that change the row count
+#define MVG_BENCHMARK_RESIZE(Mix, ...) \
+	MVG_BENCHMARK_PAIR(push_back, Mix, __VA_ARGS__); \
+	MVG_BENCHMARK_PAIR(insert, Mix, __VA_ARGS__); \
+	MVG_BENCHMARK_PAIR(erase_range, Mix, __VA_ARGS__); \
+	MVG_BENCHMARK_PAIR(remove_if, Mix, __VA_ARGS__)
+
+MVG_BENCHMARK_READ(vector1, Apply(rows<vector1>));
+MVG_BENCHMARK_READ(vector2, Apply(rows<vector2>));
+MVG_BENCHMARK_READ(vector4, Apply(rows<vector4>));
+MVG_BENCHMARK_READ(vector8, Apply(rows<vector8>));
+MVG_BENCHMARK_READ(deque4, Apply(rows<deque4>));
+MVG_BENCHMARK_READ(list4, Apply(rows<list4>));
+MVG_BENCHMARK_READ(mixed4, Apply(rows<mixed4>));
+MVG_BENCHMARK_READ(array4_1k, Arg(1024));
+MVG_BENCHMARK_READ(array4_64k, Arg(65536));
+MVG_BENCHMARK_READ(array4_1m, Arg(1048576));
+
+MVG_BENCHMARK_RANDOM_ACCESS(vector1, Apply(rows<vector1>));
+MVG_BENCHMARK_RANDOM_ACCESS(vector2, Apply(rows<vector2>));
+MVG_BENCHMARK_RANDOM_ACCESS(vector4, Apply(rows<vector4>));
+MVG_BENCHMARK_RANDOM_ACCESS(vector8, Apply(rows<vector8>));
+MVG_BENCHMARK_RANDOM_ACCESS(deque4, Apply(rows<deque4>));
+MVG_BENCHMARK_RANDOM_ACCESS(array4_1k, Arg(1024));
+MVG_BENCHMARK_RANDOM_ACCESS(array4_64k, Arg(65536));
+MVG_BENCHMARK_RANDOM_ACCESS(array4_1m, Arg(1048576));
+
+MVG_BENCHMARK_RESIZE(vector1, Apply(rows<vector1>));
+MVG_BENCHMARK_RESIZE(vector2, Apply(rows<vector2>));
+MVG_BENCHMARK_RESIZE(vector4, Apply(rows<vector4>));
+MVG_BENCHMARK_RESIZE(vector8, Apply(rows<vector8>));
+MVG_BENCHMARK_RESIZE(deque4, Apply(rows<deque4>));
+MVG_BENCHMARK_RESIZE(list4, Apply(rows<list4>));
+MVG_BENCHMARK_RESIZE(mixed4, Apply(rows<mixed4>));
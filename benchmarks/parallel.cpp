@@ -0,0 +1,141 @@
+/*Scaling of the parallel algorithms of multi_container with the amount of threads. Benchmark names are
+ *<algorithm>/<threads>/<rows>, with threads going from 1 to std::thread::hardware_concurrency() in powers of 2
+ *(and the hardware thread count itself), set with mvg::set_parallel_threads(). Times are wall clock times.
+ *The serial_* benchmarks are the same work in a plain loop on the calling thread. Rows below
+ *4096 per thread are not split, so small row counts show the point where the threads start to pay off
+*/
+#include "bench_common.hpp"
+
+#include <cmath>
+#include <thread>
+
+#include "parallel.hpp"
+
+using namespace bench;
+
+using vector4 = uniform_mix<std::vector, 4>;
+
+namespace
+{
+
+std::size_t threads_of(benchmark::State const& state)
+{
+	return static_cast<std::size_t>(state.range(0));
+}
+
+std::size_t thread_rows_of(benchmark::State const& state)
+{
+	return static_cast<std::size_t>(state.range(1));
+}
+
+//Enough work per row that the algorithms aren't only limited by memory bandwidth
+template<typename Row>
+double row_work(Row const& row)
+{
+	return std::sqrt(row_sum(row) + 1.0) * std::log(static_cast<double>(std::get<0>(row)) + 2.0);
+}
+
+//Runs the benchmark body with the parallel algorithms limited to the thread count of the benchmark
+template<typename F>
+void with_threads(benchmark::State& state, F body)
+{
+	mvg::set_parallel_threads(static_cast<unsigned>(threads_of(state)));
+	body();
+	mvg::set_parallel_threads(0);
+	set_rows_processed(state, thread_rows_of(state));
+}
+
+void for_each_row(benchmark::State& state)
+{
+	auto const c = vector4::make(thread_rows_of(state));
+	with_threads(state, [&]
+	{
+		for (auto _ : state)
+		{
+			c->for_each_row([](auto&& row) { std::get<1>(row) = row_work(row); });
+			benchmark::DoNotOptimize(c->data());
+		}
+	});
+}
+
+void transform_rows(benchmark::State& state)
+{
+	auto const c = vector4::make(thread_rows_of(state));
+	std::vector<double> out(thread_rows_of(state));
+	with_threads(state, [&]
+	{
+		for (auto _ : state)
+		{
+			c->transform_rows(out.begin(), [](auto const& row) { return row_work(row); });
+			benchmark::DoNotOptimize(out.data());
+		}
+	});
+}
+
+void reduce_rows(benchmark::State& state)
+{
+	auto const c = vector4::make(thread_rows_of(state));
+	with_threads(state, [&]
+	{
+		for (auto _ : state)
+		{
+			double const sum = c->reduce_rows(0.0, std::plus<> {}, [](auto const& row) { return row_work(row); });
+			benchmark::DoNotOptimize(sum);
+		}
+	});
+}
+
+void serial_for_each(benchmark::State& state)
+{
+	auto const c = vector4::make(rows_of(state));
+	for (auto _ : state)
+	{
+		for (auto&& row : *c)
+		{
+			std::get<1>(row) = row_work(row);
+		}
+		benchmark::DoNotOptimize(c->data());
+	}
+	set_rows_processed(state, rows_of(state));
+}
+
+void serial_reduce(benchmark::State& state)
+{
+	auto const c = vector4::make(rows_of(state));
+	for (auto _ : state)
+	{
+		double sum = 0;
+		for (auto const& row : *c)
+		{
+			sum += row_work(row);
+		}
+		benchmark::DoNotOptimize(sum);
+	}
+	set_rows_processed(state, rows_of(state));
+}
+
+void threads_and_rows(benchmark::internal::Benchmark* b)
+{
+	std::int64_t const hardware = std::max(1u, std::thread::hardware_concurrency());
+	std::vector<std::int64_t> threads;
+	for (std::int64_t t = 1; t < hardware; t *= 2)
+	{
+		threads.push_back(t);
+	}
+	threads.push_back(hardware);
+	for (std::int64_t t : threads)
+	{
+		for (std::int64_t n = 1000; n <= static_cast<std::int64_t>(vector4::max_rows); n *= 10)
+		{
+			b->Args({ t, n });
+		}
+	}
+}
+
+} //namespace
+
+BENCHMARK(for_each_row)->Apply(threads_and_rows)->UseRealTime();
+BENCHMARK(transform_rows)->Apply(threads_and_rows)->UseRealTime();
+BENCHMARK(reduce_rows)->Apply(threads_and_rows)->UseRealTime();
+BENCHMARK(serial_for_each)->Apply(rows<vector4>)->UseRealTime();
+BENCHMARK(serial_reduce)->Apply(rows<vector4>)->UseRealTime();
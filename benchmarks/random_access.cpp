@@ -0,0 +1,117 @@
+/*Cost of random access through multi_iterator as the row count grows. operator[], it + n and the probes of
+ *std::lower_bound advance every column iterator with one += when all of them are random access, so their time should
+ *not depend on the row count: every family reports its fitted complexity as <name>_BigO, which should be O(1)
+ *(O(lgN) for lower_bound). advance_list moves over list columns with std::next, which steps one row at a time through
+ *operator++ and is O(N), for comparison
+*/
+#include "bench_common.hpp"
+
+#include <deque>
+
+using namespace bench;
+
+using vector4 = uniform_mix<std::vector, 4>;
+using deque4 = uniform_mix<std::deque, 4>;
+using vector_deque = mix<std::vector<int>, std::deque<double>, std::vector<float>, std::deque<long long>>;
+using list4 = uniform_mix<std::list, 4>;
+
+namespace
+{
+
+//Row offsets from the middle of the container, so every access lands far from the previous one
+constexpr std::size_t probes = 64;
+
+std::size_t probe_row(std::size_t n, std::size_t k)
+{
+	return (n / 2 + k * (n / probes) / 2) % n;
+}
+
+//operator[] on rows spread over the whole container
+
+template<typename Mix>
+void index_rows(benchmark::State& state)
+{
+	std::size_t const n = rows_of(state);
+	auto const c = Mix::make(n);
+	for (auto _ : state)
+	{
+		double sum = 0;
+		for (std::size_t k = 0; k < probes; ++k)
+		{
+			sum += row_sum((*c)[probe_row(n, k)]);
+		}
+		benchmark::DoNotOptimize(sum);
+	}
+	state.SetComplexityN(static_cast<std::int64_t>(n));
+	set_rows_processed(state, probes);
+}
+
+//begin() + offset, without reading the row
+
+template<typename Mix>
+void advance_rows(benchmark::State& state)
+{
+	std::size_t const n = rows_of(state);
+	auto const c = Mix::make(n);
+	for (auto _ : state)
+	{
+		for (std::size_t k = 0; k < probes; ++k)
+		{
+			auto it = c->begin() + static_cast<std::ptrdiff_t>(probe_row(n, k));
+			benchmark::DoNotOptimize(it);
+		}
+	}
+	state.SetComplexityN(static_cast<std::int64_t>(n));
+	set_rows_processed(state, probes);
+}
+
+//std::lower_bound over the first column, sorted on its own
+
+template<typename Mix>
+void lower_bound_rows(benchmark::State& state)
+{
+	std::size_t const n = rows_of(state);
+	auto const c = Mix::make(n);
+	auto& keys = std::get<0>(c->data());
+	std::sort(keys.begin(), keys.end());
+	for (auto _ : state)
+	{
+		for (std::size_t k = 0; k < probes; ++k)
+		{
+			auto const key = keys[probe_row(n, k)];
+			auto it = std::lower_bound(c->begin(), c->end(), key, [](auto const& row, auto const& value) { return std::get<0>(row) < value; });
+			benchmark::DoNotOptimize(it);
+		}
+	}
+	state.SetComplexityN(static_cast<std::int64_t>(n));
+	set_rows_processed(state, probes);
+}
+
+//std::next over list columns, which can only be stepped one row at a time
+
+void advance_list(benchmark::State& state)
+{
+	std::size_t const n = rows_of(state);
+	auto const c = list4::make(n);
+	for (auto _ : state)
+	{
+		auto it = std::next(c->begin(), static_cast<std::ptrdiff_t>(n / 2));
+		benchmark::DoNotOptimize(it);
+	}
+	state.SetComplexityN(static_cast<std::int64_t>(n));
+}
+
+} //namespace
+
+BENCHMARK_TEMPLATE(index_rows, vector4)->Apply(rows<vector4>)->Complexity(benchmark::o1);
+BENCHMARK_TEMPLATE(index_rows, deque4)->Apply(rows<deque4>)->Complexity(benchmark::o1);
+BENCHMARK_TEMPLATE(index_rows, vector_deque)->Apply(rows<vector_deque>)->Complexity(benchmark::o1);
+
+BENCHMARK_TEMPLATE(advance_rows, vector4)->Apply(rows<vector4>)->Complexity(benchmark::o1);
+BENCHMARK_TEMPLATE(advance_rows, deque4)->Apply(rows<deque4>)->Complexity(benchmark::o1);
+BENCHMARK_TEMPLATE(advance_rows, vector_deque)->Apply(rows<vector_deque>)->Complexity(benchmark::o1);
+
+BENCHMARK_TEMPLATE(lower_bound_rows, vector4)->Apply(rows<vector4>)->Complexity(benchmark::oLogN);
+BENCHMARK_TEMPLATE(lower_bound_rows, deque4)->Apply(rows<deque4>)->Complexity(benchmark::oLogN);
+
+BENCHMARK(advance_list)->Apply(rows<list4>)->Complexity(benchmark::oN);
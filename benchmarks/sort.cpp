@@ -0,0 +1,80 @@
+/*Sorting containers of 4 and 8 columns by their first column, with std::sort over the rows (sort_std), which swaps whole
+ *rows through the tuple_wrapper proxies, and with the permutation based sort_by<0>(), sort_by(projection) and
+ *radix_sort_by<0>(), which sort row indices and then gather every column once. The containers are restored outside
+ *of the timed region. The full runs sort 1K and 1M rows
+*/
+#include "bench_common.hpp"
+
+#include <deque>
+
+using namespace bench;
+
+using vector4 = uniform_mix<std::vector, 4>;
+using deque4 = uniform_mix<std::deque, 4>;
+using vector8 = uniform_mix<std::vector, 8>;
+
+namespace
+{
+
+//Sorts a copy of the same unsorted container in every iteration
+template<typename Mix, typename Sort>
+void run_sort(benchmark::State& state, Sort sort)
+{
+	std::size_t const n = rows_of(state);
+	auto const original = Mix::make(n);
+	auto const c = Mix::make(n);
+	for (auto _ : state)
+	{
+		sort(*c);
+		benchmark::DoNotOptimize(c->data());
+		state.PauseTiming();
+		*c = *original;
+		state.ResumeTiming();
+	}
+	set_rows_processed(state, n);
+}
+
+template<typename Mix>
+void sort_std(benchmark::State& state)
+{
+	run_sort<Mix>(state, [](auto& c)
+	{
+		std::sort(c.begin(), c.end(), [](auto const& a, auto const& b) { return std::get<0>(a) < std::get<0>(b); });
+	});
+}
+
+template<typename Mix>
+void sort_by_column(benchmark::State& state)
+{
+	run_sort<Mix>(state, [](auto& c) { c.template sort_by<0>(); });
+}
+
+template<typename Mix>
+void sort_by_projection(benchmark::State& state)
+{
+	run_sort<Mix>(state, [](auto& c) { c.sort_by([](auto const& row) { return std::get<0>(row); }); });
+}
+
+template<typename Mix>
+void radix_sort_by_column(benchmark::State& state)
+{
+	run_sort<Mix>(state, [](auto& c) { c.template radix_sort_by<0>(); });
+}
+
+void sort_rows(benchmark::internal::Benchmark* b)
+{
+	b->Arg(1000);
+	b->Arg(static_cast<std::int64_t>(std::min<std::size_t>(1000000, MVG_BENCHMARK_MAX_ROWS)));
+}
+
+} //namespace
+
+#define MVG_BENCHMARK_SORT(Mix) \
+	BENCHMARK_TEMPLATE(sort_std, Mix)->Apply(sort_rows); \
+	BENCHMARK_TEMPLATE(sort_by_column, Mix)->Apply(sort_rows); \
+	BENCHMARK_TEMPLATE(sort_by_projection, Mix)->Apply(sort_rows); \
+	BENCHMARK_TEMPLATE(radix_sort_by_column, Mix)->Apply(sort_rows)
+
+MVG_BENCHMARK_SORT(vector4);
+MVG_BENCHMARK_SORT(deque4);
+MVG_BENCHMARK_SORT(vector8);
@@ -0,0 +1,179 @@
+/*Tight loops over a multi_container of three std::vector columns next to the same loops written by hand with one index
+ *over three parallel std::vectors. multi_iterator is trivially copyable over vector columns, so it can stay in registers
+ *when it is passed by value to algorithms, and every loop here should compile to the same code as its hand written
+ *counterpart: the <loop>_multi and <loop>_vectors times should match. Benchmark names are <loop>_<kind>/<rows>
+*/
+#include "bench_common.hpp"
+
+#include <numeric>
+#include <type_traits>
+
+using namespace bench;
+
+namespace
+{
+
+using table = mvg::multi_container<std::vector<int>, std::vector<float>, std::vector<double>>;
+
+static_assert(std::is_trivially_copyable_v<table::iterator>, "The iterator of vector columns should be trivially copyable");
+
+struct columns
+{
+	std::vector<int> a;
+	std::vector<float> b;
+	std::vector<double> c;
+};
+
+std::unique_ptr<table> make_table(std::size_t n)
+{
+	auto t = std::make_unique<table>();
+	for (std::size_t i = 0; i < n; ++i)
+	{
+		t->push_back(std::make_tuple(value<int>(i), value<float>(i), 0.0));
+	}
+	return t;
+}
+
+columns make_columns(std::size_t n)
+{
+	columns cols;
+	for (std::size_t i = 0; i < n; ++i)
+	{
+		cols.a.push_back(value<int>(i));
+		cols.b.push_back(value<float>(i));
+		cols.c.push_back(0.0);
+	}
+	return cols;
+}
+
+//Reading two columns with a range-for loop
+
+void read_multi(benchmark::State& state)
+{
+	auto const t = make_table(rows_of(state));
+	for (auto _ : state)
+	{
+		double sum = 0;
+		for (auto const& row : *t)
+		{
+			sum += std::get<0>(row) * static_cast<double>(std::get<1>(row));
+		}
+		benchmark::DoNotOptimize(sum);
+	}
+	set_rows_processed(state, rows_of(state));
+}
+
+void read_vectors(benchmark::State& state)
+{
+	auto const cols = make_columns(rows_of(state));
+	std::size_t const n = cols.a.size();
+	for (auto _ : state)
+	{
+		double sum = 0;
+		for (std::size_t i = 0; i < n; ++i)
+		{
+			sum += cols.a[i] * static_cast<double>(cols.b[i]);
+		}
+		benchmark::DoNotOptimize(sum);
+	}
+	set_rows_processed(state, n);
+}
+
+//Writing a third column from two others with an explicit iterator loop
+
+void write_multi(benchmark::State& state)
+{
+	auto const t = make_table(rows_of(state));
+	for (auto _ : state)
+	{
+		for (auto it = t->begin(), last = t->end(); it != last; ++it)
+		{
+			auto&& row = *it;
+			std::get<2>(row) = std::get<0>(row) + 2.0 * std::get<1>(row);
+		}
+		benchmark::ClobberMemory();
+	}
+	set_rows_processed(state, rows_of(state));
+}
+
+void write_vectors(benchmark::State& state)
+{
+	auto cols = make_columns(rows_of(state));
+	std::size_t const n = cols.a.size();
+	for (auto _ : state)
+	{
+		for (std::size_t i = 0; i < n; ++i)
+		{
+			cols.c[i] = cols.a[i] + 2.0 * cols.b[i];
+		}
+		benchmark::ClobberMemory();
+	}
+	set_rows_processed(state, n);
+}
+
+//std::for_each and std::accumulate, which take the iterators by value
+
+void for_each_multi(benchmark::State& state)
+{
+	auto const t = make_table(rows_of(state));
+	for (auto _ : state)
+	{
+		std::for_each(t->begin(), t->end(), [](auto&& row) { std::get<2>(row) = std::get<0>(row) + 2.0 * std::get<1>(row); });
+		benchmark::ClobberMemory();
+	}
+	set_rows_processed(state, rows_of(state));
+}
+
+void for_each_vectors(benchmark::State& state)
+{
+	auto cols = make_columns(rows_of(state));
+	std::size_t const n = cols.a.size();
+	for (auto _ : state)
+	{
+		int const* a = cols.a.data();
+		float const* b = cols.b.data();
+		std::for_each(cols.c.begin(), cols.c.end(), [&a, &b](double& c) { c = *a++ + 2.0 * *b++; });
+		benchmark::ClobberMemory();
+	}
+	set_rows_processed(state, n);
+}
+
+void accumulate_multi(benchmark::State& state)
+{
+	auto const t = make_table(rows_of(state));
+	for (auto _ : state)
+	{
+		double const sum = std::accumulate(t->begin(), t->end(), 0.0,
+			[](double acc, auto const& row) { return acc + std::get<0>(row) * static_cast<double>(std::get<1>(row)); });
+		benchmark::DoNotOptimize(sum);
+	}
+	set_rows_processed(state, rows_of(state));
+}
+
+void accumulate_vectors(benchmark::State& state)
+{
+	auto const cols = make_columns(rows_of(state));
+	for (auto _ : state)
+	{
+		double const sum = std::inner_product(cols.a.begin(), cols.a.end(), cols.b.begin(), 0.0,
+			std::plus<> {}, [](int a, float b) { return a * static_cast<double>(b); });
+		benchmark::DoNotOptimize(sum);
+	}
+	set_rows_processed(state, rows_of(state));
+}
+
+void table_rows(benchmark::internal::Benchmark* b)
+{
+	row_range(b, MVG_BENCHMARK_MAX_ROWS);
+}
+
+} //namespace
+
+BENCHMARK(read_multi)->Apply(table_rows);
+BENCHMARK(read_vectors)->Apply(table_rows);
+BENCHMARK(write_multi)->Apply(table_rows);
+BENCHMARK(write_vectors)->Apply(table_rows);
+BENCHMARK(for_each_multi)->Apply(table_rows);
+BENCHMARK(for_each_vectors)->Apply(table_rows);
+BENCHMARK(accumulate_multi)->Apply(table_rows);
+BENCHMARK(accumulate_vectors)->Apply(table_rows);
@@ -0,0 +1,462 @@
+#ifndef MVG_CHUNKED_CONTAINER_HPP_
+#define MVG_CHUNKED_CONTAINER_HPP_
+
+#include <tuple>
+#include <deque>
+#include <memory>
+#include <memory_resource>
+#include <new>
+#include <iterator>
+#include <stdexcept>
+#include <cstddef>
+
+#include "multi_iterator.hpp"
+#include "multi_vector.hpp"
+
+namespace mvg
+{
+
+/*\class: basic_chunked_container
+ *\usage: Append only structure of arrays container for unbounded ingest. Rows are stored in blocks of BlockRows rows,
+ *		  every block is one allocation laid out like a multi_vector (one column per T in Ts, every column on its own cache line).
+ *		  Appending never moves existing elements, so references to elements stay valid until their row is removed.
+ *		  Old rows are dropped a whole block at a time with pop_front_block() or retain().
+ *		  Iterators hold a pointer to the container and a row number, they stay valid when rows are added or removed at the front
+*/
+template<std::size_t BlockRows, typename... Ts>
+class basic_chunked_container
+{
+	static_assert(sizeof...(Ts) > 0, "chunked_container needs at least one column");
+	static_assert(BlockRows > 0 && (BlockRows & (BlockRows - 1)) == 0, "BlockRows must be a power of two");
+
+public:
+	using iterator = multi_iterator<detail::source_column<basic_chunked_container, Ts>...>;
+	using const_iterator = multi_iterator<detail::source_column<basic_chunked_container const, std::add_const_t<Ts>>...>;
+	using value_type = detail::tuple_wrapper<Ts...>;
+	using reference = detail::tuple_wrapper<std::add_lvalue_reference_t<Ts> ...>;
+	using const_reference = detail::tuple_wrapper<std::add_lvalue_reference_t<std::add_const_t<Ts>> ...>;
+	using pointer = std::add_pointer_t<value_type>;
+	using reverse_iterator = std::reverse_iterator<iterator>;
+	using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+	using size_type = std::size_t;
+	using difference_type = std::ptrdiff_t;
+
+	static constexpr size_type block_rows = BlockRows;
+
+	basic_chunked_container()
+	{
+	}
+
+	//Allocates all blocks from resource
+	explicit basic_chunked_container(std::pmr::memory_resource* resource) : m_resource(resource)
+	{
+	}
+
+	basic_chunked_container(basic_chunked_container const& rhs)
+	{
+		for (size_type i = 0; i < rhs.m_size; ++i)
+		{
+			push_back(rhs.row(rhs.first_row() + static_cast<difference_type>(i)));
+		}
+	}
+
+	basic_chunked_container(basic_chunked_container&& rhs) noexcept
+	{
+		swap(rhs);
+	}
+
+	basic_chunked_container& operator=(basic_chunked_container const& rhs)
+	{
+		if (this != &rhs)
+		{
+			basic_chunked_container copy { rhs };
+			swap(copy);
+		}
+		return *this;
+	}
+
+	basic_chunked_container& operator=(basic_chunked_container&& rhs) noexcept
+	{
+		basic_chunked_container moved { std::move(rhs) };
+		swap(moved);
+		return *this;
+	}
+
+	~basic_chunked_container()
+	{
+		clear();
+	}
+
+	void swap(basic_chunked_container& rhs) noexcept
+	{
+		std::swap(m_resource, rhs.m_resource);
+		m_blocks.swap(rhs.m_blocks);
+		std::swap(m_first_block, rhs.m_first_block);
+		std::swap(m_size, rhs.m_size);
+	}
+
+	friend void swap(basic_chunked_container& a, basic_chunked_container& b) noexcept
+	{
+		a.swap(b);
+	}
+
+	iterator begin()
+	{
+		return iterator(this, first_row());
+	}
+
+	iterator end()
+	{
+		return iterator(this, first_row() + static_cast<difference_type>(m_size));
+	}
+
+	const_iterator begin() const
+	{
+		return const_iterator(this, first_row());
+	}
+
+	const_iterator end() const
+	{
+		return const_iterator(this, first_row() + static_cast<difference_type>(m_size));
+	}
+
+	const_iterator cbegin() const
+	{
+		return begin();
+	}
+
+	const_iterator cend() const
+	{
+		return end();
+	}
+
+	reverse_iterator rbegin()
+	{
+		return reverse_iterator { end() };
+	}
+
+	reverse_iterator rend()
+	{
+		return reverse_iterator { begin() };
+	}
+
+	const_reverse_iterator crbegin() const
+	{
+		return const_reverse_iterator { end() };
+	}
+
+	const_reverse_iterator crend() const
+	{
+		return const_reverse_iterator { begin() };
+	}
+
+	reference operator[](size_type index)
+	{
+		dbg_assert((index < m_size), "chunked_container index out of range");
+		return begin()[index];
+	}
+
+	const_reference operator[](size_type index) const
+	{
+		dbg_assert((index < m_size), "chunked_container index out of range");
+		return begin()[index];
+	}
+
+	reference at(size_type index)
+	{
+		if (index >= m_size)
+		{
+			throw std::out_of_range("chunked_container index out of range");
+		}
+		return begin()[index];
+	}
+
+	const_reference at(size_type index) const
+	{
+		if (index >= m_size)
+		{
+			throw std::out_of_range("chunked_container index out of range");
+		}
+		return begin()[index];
+	}
+
+	reference front()
+	{
+		return *begin();
+	}
+
+	const_reference front() const
+	{
+		return *begin();
+	}
+
+	reference back()
+	{
+		return begin()[m_size - 1];
+	}
+
+	const_reference back() const
+	{
+		return begin()[m_size - 1];
+	}
+
+	//Returns references to the elements of the row with row number index. Row numbers keep counting up when
+	//blocks are removed at the front, begin().index() is the row number of the first row. Used by the iterators
+	std::tuple<std::add_lvalue_reference_t<Ts>...> row(difference_type index)
+	{
+		block const& b = block_of(index);
+		size_type const offset = static_cast<size_type>(index) % BlockRows;
+		return std::apply([offset](Ts*... columns) { return std::tuple<std::add_lvalue_reference_t<Ts>...>(columns[offset]...); },
+			b.columns);
+	}
+
+	std::tuple<std::add_lvalue_reference_t<std::add_const_t<Ts>>...> row(difference_type index) const
+	{
+		block const& b = block_of(index);
+		size_type const offset = static_cast<size_type>(index) % BlockRows;
+		return std::apply([offset](Ts*... columns) { return std::tuple<std::add_lvalue_reference_t<std::add_const_t<Ts>>...>(columns[offset]...); },
+			b.columns);
+	}
+
+	std::pmr::memory_resource* resource() const
+	{
+		return m_resource;
+	}
+
+	bool empty() const
+	{
+		return m_size == 0;
+	}
+
+	size_type size() const
+	{
+		return m_size;
+	}
+
+	size_type block_count() const
+	{
+		return m_blocks.size();
+	}
+
+	//Calls f(count, column pointers...) once for every block, with the amount of rows in that block,
+	//so every call works on contiguous columns
+	template<typename F>
+	void for_each_block(F f)
+	{
+		size_type left = m_size;
+		for (block& b : m_blocks)
+		{
+			size_type const count = std::min(left, BlockRows);
+			std::apply([&f, count](Ts*... columns) { f(count, columns...); }, b.columns);
+			left -= count;
+		}
+	}
+
+	template<typename F>
+	void for_each_block(F f) const
+	{
+		size_type left = m_size;
+		for (block const& b : m_blocks)
+		{
+			size_type const count = std::min(left, BlockRows);
+			std::apply([&f, count](Ts*... columns) { f(count, static_cast<std::add_const_t<Ts> const*>(columns)...); }, b.columns);
+			left -= count;
+		}
+	}
+
+	void clear()
+	{
+		while (!m_blocks.empty())
+		{
+			pop_back_block();
+		}
+		m_first_block = 0;
+	}
+
+	template<typename... Elems>
+	void push_back(std::tuple<Elems...> const& elems)
+	{
+		static_assert(sizeof...(Elems) == sizeof...(Ts), "Invalid argument count");
+		push_back_copy(elems, std::index_sequence_for<Ts...> {});
+	}
+
+	template<typename... Elems>
+	void push_back(std::tuple<Elems...>&& elems)
+	{
+		static_assert(sizeof...(Elems) == sizeof...(Ts), "Invalid argument count");
+		push_back_move(std::move(elems), std::index_sequence_for<Ts...> {});
+	}
+
+	//Every argument is a tuple holding the constructor arguments for the element of one column, see multi_vector::emplace_back
+	template<typename... ArgTuples>
+	void emplace_back(ArgTuples&&... args)
+	{
+		static_assert(sizeof...(ArgTuples) == sizeof...(Ts), "Invalid argument count");
+
+		size_type const offset = back_offset();
+		if (offset == 0)
+		{
+			m_blocks.push_back(block { nullptr, {} });
+		}
+		try
+		{
+			if (offset == 0)
+			{
+				m_blocks.back() = allocate_block(std::index_sequence_for<Ts...> {});
+			}
+			construct_row(m_blocks.back(), offset, std::index_sequence_for<Ts...> {}, std::forward<ArgTuples>(args)...);
+		}
+		catch (...)
+		{
+			if (offset == 0)
+			{
+				deallocate_block(m_blocks.back());
+				m_blocks.pop_back();
+			}
+			throw;
+		}
+		++m_size;
+	}
+
+	void pop_back()
+	{
+		dbg_assert((m_size > 0), "pop_back() on empty chunked_container");
+		size_type const offset = (back_offset() + BlockRows - 1) % BlockRows;
+		destroy_rows(m_blocks.back(), offset, offset + 1, std::index_sequence_for<Ts...> {});
+		--m_size;
+		if (offset == 0)
+		{
+			deallocate_block(m_blocks.back());
+			m_blocks.pop_back();
+		}
+	}
+
+	//Removes all rows of the oldest block
+	void pop_front_block()
+	{
+		dbg_assert((!m_blocks.empty()), "pop_front_block() on empty chunked_container");
+		size_type const count = std::min(m_size, BlockRows);
+		destroy_rows(m_blocks.front(), 0, count, std::index_sequence_for<Ts...> {});
+		deallocate_block(m_blocks.front());
+		m_blocks.pop_front();
+		m_size -= count;
+		++m_first_block;
+	}
+
+	//Removes whole blocks at the front, as long as at least rows rows are left
+	void retain(size_type rows)
+	{
+		while (m_blocks.size() > 1 && m_size - BlockRows >= rows)
+		{
+			pop_front_block();
+		}
+	}
+
+private:
+	using layout_type = detail::soa_layout<Ts...>;
+
+	struct block
+	{
+		void* data;
+		std::tuple<Ts*...> columns;
+	};
+
+	difference_type first_row() const
+	{
+		return static_cast<difference_type>(m_first_block * BlockRows);
+	}
+
+	//Position of the next row in the last block, 0 when a new block is needed
+	size_type back_offset() const
+	{
+		return m_size % BlockRows;
+	}
+
+	block const& block_of(difference_type index) const
+	{
+		return m_blocks[static_cast<size_type>(index) / BlockRows - m_first_block];
+	}
+
+	template<std::size_t... Is>
+	block allocate_block(std::index_sequence<Is...>)
+	{
+		static constexpr layout_type layout { BlockRows };
+		void* data = m_resource->allocate(layout.bytes, layout_type::alignment);
+		return block { data, std::tuple<Ts*...> { reinterpret_cast<Ts*>(static_cast<char*>(data) + layout.offsets[Is]) ... } };
+	}
+
+	void deallocate_block(block const& b)
+	{
+		if (b.data)
+		{
+			m_resource->deallocate(b.data, layout_type(BlockRows).bytes, layout_type::alignment);
+		}
+	}
+
+	//Destroys the rows of the last block and frees it
+	void pop_back_block()
+	{
+		size_type const count = m_size - (m_blocks.size() - 1) * BlockRows;
+		destroy_rows(m_blocks.back(), 0, count, std::index_sequence_for<Ts...> {});
+		deallocate_block(m_blocks.back());
+		m_blocks.pop_back();
+		m_size -= count;
+	}
+
+	template<std::size_t... Is>
+	static void destroy_rows(block const& b, size_type first, size_type last, std::index_sequence<Is...>)
+	{
+		(std::destroy(std::get<Is>(b.columns) + first, std::get<Is>(b.columns) + last), ...);
+	}
+
+	template<std::size_t I, typename Args>
+	static void construct_element(block const& b, size_type offset, Args&& args)
+	{
+		using T = std::tuple_element_t<I, std::tuple<Ts...>>;
+		T* where = std::get<I>(b.columns) + offset;
+		std::apply([where](auto&&... a) { ::new (static_cast<void*>(where)) T(std::forward<decltype(a)>(a) ...); },
+			std::forward<Args>(args));
+	}
+
+	//Constructs the elements of a row from the argument tuples in args. If one of the constructors throws,
+	//the elements that were already constructed are destroyed again
+	template<std::size_t... Is, typename... ArgTuples>
+	static void construct_row(block const& b, size_type offset, std::index_sequence<Is...>, ArgTuples&&... args)
+	{
+		std::size_t constructed = 0;
+		try
+		{
+			((construct_element<Is>(b, offset, std::forward<ArgTuples>(args)), ++constructed), ...);
+		}
+		catch (...)
+		{
+			((Is < constructed ? std::destroy_at(std::get<Is>(b.columns) + offset) : (void)0), ...);
+			throw;
+		}
+	}
+
+	template<typename... Elems, std::size_t... Is>
+	void push_back_copy(std::tuple<Elems...> const& elems, std::index_sequence<Is...>)
+	{
+		emplace_back(std::forward_as_tuple(std::get<Is>(elems)) ...);
+	}
+
+	template<typename... Elems, std::size_t... Is>
+	void push_back_move(std::tuple<Elems...>&& elems, std::index_sequence<Is...>)
+	{
+		emplace_back(std::forward_as_tuple(std::get<Is>(std::move(elems))) ...);
+	}
+
+	std::pmr::memory_resource* m_resource = std::pmr::get_default_resource();
+	std::deque<block> m_blocks;
+	size_type m_first_block = 0; //Amount of blocks removed at the front, so row numbers stay stable
+	size_type m_size = 0;
+};
+
+/*chunked_container with blocks of 4096 rows*/
+template<typename... Ts>
+using chunked_container = basic_chunked_container<4096, Ts...>;
+
+} //namespace mvg
+
+#endif
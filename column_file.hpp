@@ -0,0 +1,165 @@
+#ifndef MVG_COLUMN_FILE_HPP_
+#define MVG_COLUMN_FILE_HPP_
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <filesystem>
+#include <stdexcept>
+#include <type_traits>
+
+namespace mvg
+{
+
+/*Id stored with every column of a saved file, which mvg::load_mmap() compares with the id of the type it maps the column as.
+ *The built in type tag only tells apart arithmetic types of different kinds and sizes, so specialize this for your own
+ *trivially copyable types with a value that is unique for the type, to reject files holding a different type of the same
+ *size and alignment, e.g.
+ *template<> struct mvg::column_type_id<point> : std::integral_constant<std::uint64_t, 0x706F696E74> {};*/
+template<typename T>
+struct column_type_id : std::integral_constant<std::uint64_t, 0> {};
+
+template<typename T>
+static constexpr std::uint64_t column_type_id_v = column_type_id<std::remove_cv_t<T>>::value;
+
+namespace detail
+{
+
+/*Columnar binary format written by multi_container::save() and read by mvg::load_mmap():
+ *
+ *column_file_header
+ *column_file_column[column_count]
+ *padding up to column_file_alignment
+ *payload of column 0, padded to column_file_alignment
+ *payload of column 1, ...
+ *
+ *Every payload is the raw bytes of row_count elements, starting at an offset that is a multiple of column_file_alignment,
+ *so a mapped file can be used in place. Values are stored in the byte order of the machine that wrote them,
+ *the endian field is used to reject files written on a machine with a different byte order*/
+
+static constexpr char column_file_magic[4] = { 'M', 'V', 'G', 'C' };
+static constexpr std::uint32_t column_file_version = 2;
+static constexpr std::uint32_t column_file_endian = 0x01020304;
+static constexpr std::uint64_t column_file_alignment = 64;
+
+struct column_file_header
+{
+	char magic[4];
+	std::uint32_t version;
+	std::uint32_t endian;
+	std::uint32_t column_count;
+	std::uint64_t row_count;
+};
+
+struct column_file_column
+{
+	std::uint64_t type_tag;
+	std::uint64_t type_id;
+	std::uint64_t element_size;
+	std::uint64_t element_alignment;
+	std::uint64_t offset;
+	std::uint64_t bytes;
+};
+
+/*Tag stored for every column, so loading a file with the wrong column types fails instead of reinterpreting bytes.
+ *The upper half is the kind of type (signed, unsigned, floating point, bool or other), the lower half its size*/
+template<typename T>
+constexpr std::uint64_t column_type_tag()
+{
+	std::uint64_t kind = 0;
+	if constexpr (std::is_same_v<T, bool>)
+	{
+		kind = 4;
+	}
+	else if constexpr (std::is_floating_point_v<T>)
+	{
+		kind = 3;
+	}
+	else if constexpr (std::is_integral_v<T> && std::is_unsigned_v<T>)
+	{
+		kind = 2;
+	}
+	else if constexpr (std::is_integral_v<T>)
+	{
+		kind = 1;
+	}
+	return (kind << 32) | sizeof(T);
+}
+
+constexpr std::uint64_t column_file_align(std::uint64_t offset)
+{
+	return (offset + column_file_alignment - 1) / column_file_alignment * column_file_alignment;
+}
+
+/*Writes rows elements of every column to path in the format described above. Throws std::runtime_error on failure*/
+template<typename... Ts>
+void save_columns(std::filesystem::path const& path, std::size_t rows, Ts const*... columns)
+{
+	static_assert((std::is_trivially_copyable_v<Ts> && ...), "Only trivially copyable columns can be saved");
+	static_assert(((alignof(Ts) <= column_file_alignment) && ...), "Column alignment is larger than the file alignment");
+
+	column_file_header header {};
+	std::memcpy(header.magic, column_file_magic, sizeof(header.magic));
+	header.version = column_file_version;
+	header.endian = column_file_endian;
+	header.column_count = static_cast<std::uint32_t>(sizeof...(Ts));
+	header.row_count = rows;
+
+	column_file_column descs[] = { column_file_column { column_type_tag<Ts>(), column_type_id_v<Ts>, sizeof(Ts), alignof(Ts), 0, rows * sizeof(Ts) } ... };
+	std::uint64_t offset = column_file_align(sizeof(column_file_header) + sizeof(descs));
+	for (column_file_column& desc : descs)
+	{
+		desc.offset = offset;
+		offset = column_file_align(offset + desc.bytes);
+	}
+
+	std::ofstream out(path, std::ios::binary | std::ios::trunc);
+	if (!out)
+	{
+		throw std::runtime_error("Can't open file for writing");
+	}
+
+	static constexpr char padding[column_file_alignment] = {};
+	out.write(reinterpret_cast<char const*>(&header), sizeof(header));
+	out.write(reinterpret_cast<char const*>(descs), sizeof(descs));
+	std::uint64_t written = sizeof(header) + sizeof(descs);
+
+	std::size_t i = 0;
+	auto write_column = [&](auto const* column)
+	{
+		out.write(padding, static_cast<std::streamsize>(descs[i].offset - written));
+		if (descs[i].bytes > 0)
+		{
+			out.write(reinterpret_cast<char const*>(column), static_cast<std::streamsize>(descs[i].bytes));
+		}
+		written = descs[i].offset + descs[i].bytes;
+		++i;
+	};
+	(write_column(columns), ...);
+
+	if (!out.flush())
+	{
+		throw std::runtime_error("Can't write file");
+	}
+}
+
+/*\class: column_writer
+ *\usage: save_columns() for containers that only declare this class, like mvg::multi_container, so <filesystem> and <fstream>
+ *		  are only included where this header is. Container isn't used, it makes the call depend on the container type
+*/
+template<typename Container>
+struct column_writer
+{
+	template<typename... Ts>
+	static void save(std::filesystem::path const& path, std::size_t rows, Ts const*... columns)
+	{
+		save_columns(path, rows, columns...);
+	}
+};
+
+} //namespace detail
+
+} //namespace mvg
+
+#endif
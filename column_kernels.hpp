@@ -0,0 +1,619 @@
+#ifndef MVG_COLUMN_KERNELS_HPP_
+#define MVG_COLUMN_KERNELS_HPP_
+
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <type_traits>
+#include <utility>
+#include <algorithm>
+
+#if __cplusplus >= 202002L
+#include <span>
+#endif
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+/*SSE2 is always available on x86-64. The AVX2 paths are only compiled in when the compiler targets AVX2
+ *(-mavx2 for gcc and clang, /arch:AVX2 for msvc)*/
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define MVG_COLUMN_KERNELS_SSE2 1
+#include <emmintrin.h>
+#endif
+
+#if defined(__AVX2__)
+#define MVG_COLUMN_KERNELS_AVX2 1
+#include <immintrin.h>
+#endif
+
+namespace mvg
+{
+
+//Extent of a batch_span whose size is only known at run time
+inline constexpr std::size_t dynamic_extent = std::numeric_limits<std::size_t>::max();
+
+/*\class: batch_span
+ *\usage: The elements of one column in a batch of rows, passed to the callback of for_each_batch. It is a pointer and a size
+ *		  like C++20's std::span (and converts to it with C++20). Full batches have their size as Extent,
+ *		  so loops up to size() have a fixed trip count and can be unrolled and vectorized
+*/
+template<typename T, std::size_t Extent = dynamic_extent>
+class batch_span
+{
+public:
+	using element_type = T;
+	using value_type = std::remove_cv_t<T>;
+	using size_type = std::size_t;
+	using pointer = T*;
+	using reference = T&;
+	using iterator = T*;
+
+	static constexpr std::size_t extent = Extent;
+
+	constexpr explicit batch_span(T* data) : m_data(data)
+	{
+	}
+
+	constexpr T* data() const
+	{
+		return m_data;
+	}
+
+	static constexpr std::size_t size()
+	{
+		return Extent;
+	}
+
+	static constexpr bool empty()
+	{
+		return Extent == 0;
+	}
+
+	constexpr T& operator[](std::size_t index) const
+	{
+		return m_data[index];
+	}
+
+	constexpr T* begin() const
+	{
+		return m_data;
+	}
+
+	constexpr T* end() const
+	{
+		return m_data + Extent;
+	}
+
+#if __cplusplus >= 202002L
+	constexpr operator std::span<T, Extent>() const
+	{
+		return std::span<T, Extent>(m_data, Extent);
+	}
+#endif
+
+private:
+	T* m_data;
+};
+
+template<typename T>
+class batch_span<T, dynamic_extent>
+{
+public:
+	using element_type = T;
+	using value_type = std::remove_cv_t<T>;
+	using size_type = std::size_t;
+	using pointer = T*;
+	using reference = T&;
+	using iterator = T*;
+
+	static constexpr std::size_t extent = dynamic_extent;
+
+	constexpr batch_span(T* data, std::size_t size) : m_data(data), m_size(size)
+	{
+	}
+
+	constexpr T* data() const
+	{
+		return m_data;
+	}
+
+	constexpr std::size_t size() const
+	{
+		return m_size;
+	}
+
+	constexpr bool empty() const
+	{
+		return m_size == 0;
+	}
+
+	constexpr T& operator[](std::size_t index) const
+	{
+		return m_data[index];
+	}
+
+	constexpr T* begin() const
+	{
+		return m_data;
+	}
+
+	constexpr T* end() const
+	{
+		return m_data + m_size;
+	}
+
+#if __cplusplus >= 202002L
+	constexpr operator std::span<T>() const
+	{
+		return std::span<T>(m_data, m_size);
+	}
+#endif
+
+private:
+	T* m_data;
+	std::size_t m_size;
+};
+
+namespace detail
+{
+
+/*Calls f once for every batch of W rows, with a batch_span over the rows of the batch in every column.
+ *Full batches get batch_span<T, W>, so loops over them can be unrolled and vectorized,
+ *the last (smaller) batch gets batch_span<T> with its size*/
+template<std::size_t W, typename F, typename... Ps>
+void for_each_batch(std::size_t n, F& f, Ps*... columns)
+{
+	static_assert(W > 0 && W != dynamic_extent, "Invalid batch width");
+
+	std::size_t i = 0;
+	for (; i + W <= n; i += W)
+	{
+		f(batch_span<Ps, W>(columns + i) ...);
+	}
+	if (i < n)
+	{
+		f(batch_span<Ps>(columns + i, n - i) ...);
+	}
+}
+
+//Type used to sum values of type T. Integers are summed in 64 bit integers
+template<typename T>
+using column_sum_t = std::conditional_t<std::is_floating_point_v<T>, T,
+	std::conditional_t<std::is_signed_v<T>, long long, unsigned long long>>;
+
+#ifdef MVG_COLUMN_KERNELS_SSE2
+inline float horizontal_sum(__m128 v)
+{
+	__m128 shuf = _mm_movehl_ps(v, v);
+	v = _mm_add_ps(v, shuf);
+	shuf = _mm_shuffle_ps(v, v, 1);
+	return _mm_cvtss_f32(_mm_add_ss(v, shuf));
+}
+
+inline double horizontal_sum(__m128d v)
+{
+	return _mm_cvtsd_f64(_mm_add_sd(v, _mm_unpackhi_pd(v, v)));
+}
+#endif
+
+#ifdef MVG_COLUMN_KERNELS_AVX2
+inline float horizontal_sum(__m256 v)
+{
+	return horizontal_sum(_mm_add_ps(_mm256_castps256_ps128(v), _mm256_extractf128_ps(v, 1)));
+}
+
+inline double horizontal_sum(__m256d v)
+{
+	return horizontal_sum(_mm_add_pd(_mm256_castpd256_pd128(v), _mm256_extractf128_pd(v, 1)));
+}
+#endif
+
+/*Sum of the n values starting at p. Floating point sums are computed with multiple accumulators,
+ *so the result can differ slightly from a sequential sum*/
+template<typename T>
+column_sum_t<T> column_sum(T const* p, std::size_t n)
+{
+	using R = column_sum_t<T>;
+	std::size_t i = 0;
+	R result = R();
+
+	if constexpr (std::is_same_v<T, float>)
+	{
+#if defined(MVG_COLUMN_KERNELS_AVX2)
+		__m256 acc0 = _mm256_setzero_ps(), acc1 = _mm256_setzero_ps();
+		for (; i + 16 <= n; i += 16)
+		{
+			acc0 = _mm256_add_ps(acc0, _mm256_loadu_ps(p + i));
+			acc1 = _mm256_add_ps(acc1, _mm256_loadu_ps(p + i + 8));
+		}
+		result = horizontal_sum(_mm256_add_ps(acc0, acc1));
+#elif defined(MVG_COLUMN_KERNELS_SSE2)
+		__m128 acc0 = _mm_setzero_ps(), acc1 = _mm_setzero_ps();
+		for (; i + 8 <= n; i += 8)
+		{
+			acc0 = _mm_add_ps(acc0, _mm_loadu_ps(p + i));
+			acc1 = _mm_add_ps(acc1, _mm_loadu_ps(p + i + 4));
+		}
+		result = horizontal_sum(_mm_add_ps(acc0, acc1));
+#endif
+	}
+	else if constexpr (std::is_same_v<T, double>)
+	{
+#if defined(MVG_COLUMN_KERNELS_AVX2)
+		__m256d acc0 = _mm256_setzero_pd(), acc1 = _mm256_setzero_pd();
+		for (; i + 8 <= n; i += 8)
+		{
+			acc0 = _mm256_add_pd(acc0, _mm256_loadu_pd(p + i));
+			acc1 = _mm256_add_pd(acc1, _mm256_loadu_pd(p + i + 4));
+		}
+		result = horizontal_sum(_mm256_add_pd(acc0, acc1));
+#elif defined(MVG_COLUMN_KERNELS_SSE2)
+		__m128d acc0 = _mm_setzero_pd(), acc1 = _mm_setzero_pd();
+		for (; i + 4 <= n; i += 4)
+		{
+			acc0 = _mm_add_pd(acc0, _mm_loadu_pd(p + i));
+			acc1 = _mm_add_pd(acc1, _mm_loadu_pd(p + i + 2));
+		}
+		result = horizontal_sum(_mm_add_pd(acc0, acc1));
+#endif
+	}
+	else if constexpr (std::is_integral_v<T> && std::is_signed_v<T> && sizeof(T) == 4)
+	{
+#if defined(MVG_COLUMN_KERNELS_AVX2)
+		__m256i acc0 = _mm256_setzero_si256(), acc1 = _mm256_setzero_si256();
+		for (; i + 8 <= n; i += 8)
+		{
+			acc0 = _mm256_add_epi64(acc0, _mm256_cvtepi32_epi64(_mm_loadu_si128(reinterpret_cast<__m128i const*>(p + i))));
+			acc1 = _mm256_add_epi64(acc1, _mm256_cvtepi32_epi64(_mm_loadu_si128(reinterpret_cast<__m128i const*>(p + i + 4))));
+		}
+		alignas(32) long long lanes[4];
+		_mm256_store_si256(reinterpret_cast<__m256i*>(lanes), _mm256_add_epi64(acc0, acc1));
+		result = (lanes[0] + lanes[1]) + (lanes[2] + lanes[3]);
+#endif
+	}
+
+	//Scalar fallback, and the elements left over by the vectorized loops
+	R acc[4] = { R(), R(), R(), R() };
+	for (; i + 4 <= n; i += 4)
+	{
+		acc[0] += p[i];
+		acc[1] += p[i + 1];
+		acc[2] += p[i + 2];
+		acc[3] += p[i + 3];
+	}
+	for (; i < n; ++i)
+	{
+		acc[0] += p[i];
+	}
+	return result + ((acc[0] + acc[1]) + (acc[2] + acc[3]));
+}
+
+/*Smallest and largest of the n values starting at p, compared with operator<. n must be greater than zero.
+ *The SIMD lanes start at p[0], and min/max(v, acc) keep acc when v is NaN, like the scalar loop where p[i] < lo is
+ *false, so the result is the same on every path: NaNs are skipped, unless p[0] is NaN, which makes both results NaN*/
+template<typename T>
+std::pair<T, T> column_min_max(T const* p, std::size_t n)
+{
+	std::size_t i = 0;
+	T lo = p[0];
+	T hi = p[0];
+
+	if constexpr (std::is_same_v<T, float>)
+	{
+#if defined(MVG_COLUMN_KERNELS_AVX2)
+		if (n >= 8)
+		{
+			__m256 vlo = _mm256_set1_ps(lo), vhi = vlo;
+			for (i = 0; i + 8 <= n; i += 8)
+			{
+				__m256 v = _mm256_loadu_ps(p + i);
+				vlo = _mm256_min_ps(v, vlo);
+				vhi = _mm256_max_ps(v, vhi);
+			}
+			alignas(32) float los[8], his[8];
+			_mm256_store_ps(los, vlo);
+			_mm256_store_ps(his, vhi);
+			lo = *std::min_element(los, los + 8);
+			hi = *std::max_element(his, his + 8);
+		}
+#elif defined(MVG_COLUMN_KERNELS_SSE2)
+		if (n >= 4)
+		{
+			__m128 vlo = _mm_set1_ps(lo), vhi = vlo;
+			for (i = 0; i + 4 <= n; i += 4)
+			{
+				__m128 v = _mm_loadu_ps(p + i);
+				vlo = _mm_min_ps(v, vlo);
+				vhi = _mm_max_ps(v, vhi);
+			}
+			alignas(16) float los[4], his[4];
+			_mm_store_ps(los, vlo);
+			_mm_store_ps(his, vhi);
+			lo = *std::min_element(los, los + 4);
+			hi = *std::max_element(his, his + 4);
+		}
+#endif
+	}
+	else if constexpr (std::is_same_v<T, double>)
+	{
+#if defined(MVG_COLUMN_KERNELS_AVX2)
+		if (n >= 4)
+		{
+			__m256d vlo = _mm256_set1_pd(lo), vhi = vlo;
+			for (i = 0; i + 4 <= n; i += 4)
+			{
+				__m256d v = _mm256_loadu_pd(p + i);
+				vlo = _mm256_min_pd(v, vlo);
+				vhi = _mm256_max_pd(v, vhi);
+			}
+			alignas(32) double los[4], his[4];
+			_mm256_store_pd(los, vlo);
+			_mm256_store_pd(his, vhi);
+			lo = *std::min_element(los, los + 4);
+			hi = *std::max_element(his, his + 4);
+		}
+#elif defined(MVG_COLUMN_KERNELS_SSE2)
+		if (n >= 2)
+		{
+			__m128d vlo = _mm_set1_pd(lo), vhi = vlo;
+			for (i = 0; i + 2 <= n; i += 2)
+			{
+				__m128d v = _mm_loadu_pd(p + i);
+				vlo = _mm_min_pd(v, vlo);
+				vhi = _mm_max_pd(v, vhi);
+			}
+			alignas(16) double los[2], his[2];
+			_mm_store_pd(los, vlo);
+			_mm_store_pd(his, vhi);
+			lo = std::min(los[0], los[1]);
+			hi = std::max(his[0], his[1]);
+		}
+#endif
+	}
+	else if constexpr (std::is_integral_v<T> && std::is_signed_v<T> && sizeof(T) == 4)
+	{
+#if defined(MVG_COLUMN_KERNELS_AVX2)
+		if (n >= 8)
+		{
+			__m256i vlo = _mm256_loadu_si256(reinterpret_cast<__m256i const*>(p)), vhi = vlo;
+			for (i = 8; i + 8 <= n; i += 8)
+			{
+				__m256i v = _mm256_loadu_si256(reinterpret_cast<__m256i const*>(p + i));
+				vlo = _mm256_min_epi32(vlo, v);
+				vhi = _mm256_max_epi32(vhi, v);
+			}
+			alignas(32) T los[8], his[8];
+			_mm256_store_si256(reinterpret_cast<__m256i*>(los), vlo);
+			_mm256_store_si256(reinterpret_cast<__m256i*>(his), vhi);
+			lo = *std::min_element(los, los + 8);
+			hi = *std::max_element(his, his + 8);
+		}
+#endif
+	}
+
+	for (; i < n; ++i)
+	{
+		if (p[i] < lo)
+		{
+			lo = p[i];
+		}
+		if (hi < p[i])
+		{
+			hi = p[i];
+		}
+	}
+	return { lo, hi };
+}
+
+/*Dot product of the n values starting at a and b*/
+template<typename T, typename U>
+auto column_dot(T const* a, U const* b, std::size_t n)
+{
+	using R = column_sum_t<std::common_type_t<T, U>>;
+	std::size_t i = 0;
+	R result = R();
+
+	if constexpr (std::is_same_v<T, float> && std::is_same_v<U, float>)
+	{
+#if defined(MVG_COLUMN_KERNELS_AVX2)
+		__m256 acc0 = _mm256_setzero_ps(), acc1 = _mm256_setzero_ps();
+		for (; i + 16 <= n; i += 16)
+		{
+			acc0 = _mm256_add_ps(acc0, _mm256_mul_ps(_mm256_loadu_ps(a + i), _mm256_loadu_ps(b + i)));
+			acc1 = _mm256_add_ps(acc1, _mm256_mul_ps(_mm256_loadu_ps(a + i + 8), _mm256_loadu_ps(b + i + 8)));
+		}
+		result = horizontal_sum(_mm256_add_ps(acc0, acc1));
+#elif defined(MVG_COLUMN_KERNELS_SSE2)
+		__m128 acc0 = _mm_setzero_ps(), acc1 = _mm_setzero_ps();
+		for (; i + 8 <= n; i += 8)
+		{
+			acc0 = _mm_add_ps(acc0, _mm_mul_ps(_mm_loadu_ps(a + i), _mm_loadu_ps(b + i)));
+			acc1 = _mm_add_ps(acc1, _mm_mul_ps(_mm_loadu_ps(a + i + 4), _mm_loadu_ps(b + i + 4)));
+		}
+		result = horizontal_sum(_mm_add_ps(acc0, acc1));
+#endif
+	}
+	else if constexpr (std::is_same_v<T, double> && std::is_same_v<U, double>)
+	{
+#if defined(MVG_COLUMN_KERNELS_AVX2)
+		__m256d acc0 = _mm256_setzero_pd(), acc1 = _mm256_setzero_pd();
+		for (; i + 8 <= n; i += 8)
+		{
+			acc0 = _mm256_add_pd(acc0, _mm256_mul_pd(_mm256_loadu_pd(a + i), _mm256_loadu_pd(b + i)));
+			acc1 = _mm256_add_pd(acc1, _mm256_mul_pd(_mm256_loadu_pd(a + i + 4), _mm256_loadu_pd(b + i + 4)));
+		}
+		result = horizontal_sum(_mm256_add_pd(acc0, acc1));
+#elif defined(MVG_COLUMN_KERNELS_SSE2)
+		__m128d acc0 = _mm_setzero_pd(), acc1 = _mm_setzero_pd();
+		for (; i + 4 <= n; i += 4)
+		{
+			acc0 = _mm_add_pd(acc0, _mm_mul_pd(_mm_loadu_pd(a + i), _mm_loadu_pd(b + i)));
+			acc1 = _mm_add_pd(acc1, _mm_mul_pd(_mm_loadu_pd(a + i + 2), _mm_loadu_pd(b + i + 2)));
+		}
+		result = horizontal_sum(_mm_add_pd(acc0, acc1));
+#endif
+	}
+
+	//Scalar fallback, and the elements left over by the vectorized loops
+	R acc[4] = { R(), R(), R(), R() };
+	for (; i + 4 <= n; i += 4)
+	{
+		acc[0] += static_cast<R>(a[i]) * static_cast<R>(b[i]);
+		acc[1] += static_cast<R>(a[i + 1]) * static_cast<R>(b[i + 1]);
+		acc[2] += static_cast<R>(a[i + 2]) * static_cast<R>(b[i + 2]);
+		acc[3] += static_cast<R>(a[i + 3]) * static_cast<R>(b[i + 3]);
+	}
+	for (; i < n; ++i)
+	{
+		acc[0] += static_cast<R>(a[i]) * static_cast<R>(b[i]);
+	}
+	return result + ((acc[0] + acc[1]) + (acc[2] + acc[3]));
+}
+
+//Index of the lowest set bit of bits, which can't be zero
+inline int lowest_bit(std::uint64_t bits)
+{
+#if defined(_MSC_VER)
+	unsigned long index;
+	_BitScanForward64(&index, bits);
+	return static_cast<int>(index);
+#else
+	return __builtin_ctzll(bits);
+#endif
+}
+
+//Bit j is set if mask[j] is not zero, for the 16 one or four byte integers starting at mask
+template<typename M>
+std::uint32_t nonzero_bits16(M const* mask)
+{
+#if defined(MVG_COLUMN_KERNELS_SSE2)
+	__m128i const zero = _mm_setzero_si128();
+	if constexpr (sizeof(M) == 1)
+	{
+		__m128i const v = _mm_loadu_si128(reinterpret_cast<__m128i const*>(mask));
+		return ~static_cast<std::uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(v, zero))) & 0xFFFFu;
+	}
+	else
+	{
+		std::uint32_t zeros = 0;
+		for (int k = 0; k < 4; ++k)
+		{
+			__m128i const v = _mm_loadu_si128(reinterpret_cast<__m128i const*>(mask + 4 * k));
+			zeros |= static_cast<std::uint32_t>(_mm_movemask_ps(_mm_castsi128_ps(_mm_cmpeq_epi32(v, zero)))) << (4 * k);
+		}
+		return ~zeros & 0xFFFFu;
+	}
+#else
+	std::uint32_t bits = 0;
+	for (int j = 0; j < 16; ++j)
+	{
+		bits |= static_cast<std::uint32_t>(mask[j] != 0) << j;
+	}
+	return bits;
+#endif
+}
+
+/*Copies the values[i] for which mask[i] converts to true to out, in order. Returns the end of the output range.
+ *Integral masks of one or four bytes (like bool, char and int) are tested 16 at a time (32 at a time for one byte masks
+ *with AVX2) with SSE2 compares: blocks without a set mask are skipped, fully set blocks are copied at once,
+ *and the values of other blocks are picked by scanning the set bits. Other mask types test every value*/
+template<typename T, typename M, typename OutputIt>
+OutputIt column_masked_select(T const* values, M const* mask, std::size_t n, OutputIt out)
+{
+	std::size_t i = 0;
+
+	if constexpr (std::is_integral_v<M> && (sizeof(M) == 1 || sizeof(M) == 4))
+	{
+#if defined(MVG_COLUMN_KERNELS_AVX2)
+		if constexpr (sizeof(M) == 1)
+		{
+			__m256i const zero = _mm256_setzero_si256();
+			for (; i + 32 <= n; i += 32)
+			{
+				__m256i const v = _mm256_loadu_si256(reinterpret_cast<__m256i const*>(mask + i));
+				std::uint64_t bits = ~static_cast<std::uint32_t>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(v, zero)));
+				if (bits == 0xFFFFFFFFu)
+				{
+					out = std::copy_n(values + i, 32, out);
+					continue;
+				}
+				for (; bits != 0; bits &= bits - 1)
+				{
+					*out = values[i + lowest_bit(bits)];
+					++out;
+				}
+			}
+		}
+#endif
+		for (; i + 16 <= n; i += 16)
+		{
+			std::uint64_t bits = nonzero_bits16(mask + i);
+			if (bits == 0xFFFFu)
+			{
+				out = std::copy_n(values + i, 16, out);
+				continue;
+			}
+			for (; bits != 0; bits &= bits - 1)
+			{
+				*out = values[i + lowest_bit(bits)];
+				++out;
+			}
+		}
+	}
+
+	for (; i < n; ++i)
+	{
+		if (mask[i])
+		{
+			*out = values[i];
+			++out;
+		}
+	}
+	return out;
+}
+
+/*\class: column_kernels
+ *\usage: The kernels above for containers that only declare this class, like mvg::multi_container, so the SIMD intrinsics
+ *		  are only included where this header is. Container isn't used, it makes the calls depend on the container type
+*/
+template<typename Container>
+struct column_kernels
+{
+	template<std::size_t W, typename F, typename... Ps>
+	static void for_each_batch(std::size_t n, F& f, Ps*... columns)
+	{
+		detail::for_each_batch<W>(n, f, columns...);
+	}
+
+	template<typename T>
+	static column_sum_t<T> sum(T const* p, std::size_t n)
+	{
+		return column_sum(p, n);
+	}
+
+	template<typename T>
+	static std::pair<T, T> min_max(T const* p, std::size_t n)
+	{
+		return column_min_max(p, n);
+	}
+
+	template<typename T, typename U>
+	static auto dot(T const* a, U const* b, std::size_t n)
+	{
+		return column_dot(a, b, n);
+	}
+
+	template<typename T, typename M, typename OutputIt>
+	static OutputIt masked_select(T const* values, M const* mask, std::size_t n, OutputIt out)
+	{
+		return column_masked_select(values, mask, n, out);
+	}
+};
+
+} //namespace detail
+
+} //namespace mvg
+
+#endif
@@ -0,0 +1,87 @@
+#ifndef MVG_COLUMN_VIEW_HPP_
+#define MVG_COLUMN_VIEW_HPP_
+
+#include <cstddef>
+#include <iterator>
+#include <type_traits>
+
+#include "multi_iterator.hpp"
+
+namespace mvg
+{
+
+/*\class: column_view
+ *\usage: Non owning view over some of the columns of a multi_container or multi_vector, returned by their columns<...>() methods.
+ *		  Its iterators only hold and advance the selected columns, and dereference to a tuple_wrapper of those columns only,
+ *		  so the other columns are never touched. It stays valid as long as the iterators it was created from are valid
+*/
+template<typename It>
+class column_view
+{
+public:
+	using iterator = It;
+	using const_iterator = It;
+	using value_type = typename std::iterator_traits<It>::value_type;
+	using reference = typename std::iterator_traits<It>::reference;
+	using size_type = std::size_t;
+	using difference_type = typename std::iterator_traits<It>::difference_type;
+
+	column_view(It first, It last, size_type size) : m_first(first), m_last(last), m_size(size)
+	{
+	}
+
+	iterator begin() const
+	{
+		return m_first;
+	}
+
+	iterator end() const
+	{
+		return m_last;
+	}
+
+	const_iterator cbegin() const
+	{
+		return m_first;
+	}
+
+	const_iterator cend() const
+	{
+		return m_last;
+	}
+
+	size_type size() const
+	{
+		return m_size;
+	}
+
+	bool empty() const
+	{
+		return m_size == 0;
+	}
+
+	reference operator[](size_type index) const
+	{
+		dbg_assert((index < m_size), "column_view index out of range");
+		return m_first[static_cast<difference_type>(index)];
+	}
+
+	reference front() const
+	{
+		return *m_first;
+	}
+
+	reference back() const
+	{
+		return *std::next(m_first, static_cast<difference_type>(m_size) - 1);
+	}
+
+private:
+	It m_first;
+	It m_last;
+	size_type m_size;
+};
+
+} //namespace mvg
+
+#endif
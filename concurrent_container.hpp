@@ -0,0 +1,322 @@
+#ifndef MVG_CONCURRENT_CONTAINER_HPP_
+#define MVG_CONCURRENT_CONTAINER_HPP_
+
+#include <tuple>
+#include <array>
+#include <atomic>
+#include <memory>
+#include <memory_resource>
+#include <new>
+#include <iterator>
+#include <stdexcept>
+#include <cstddef>
+#include <cstdint>
+
+#include "multi_iterator.hpp"
+#include "multi_vector.hpp"
+#include "column_view.hpp"
+
+namespace mvg
+{
+
+namespace detail
+{
+
+inline std::size_t floor_log2(std::uint64_t v)
+{
+#if defined(__GNUC__) || defined(__clang__)
+	return 63 - static_cast<std::size_t>(__builtin_clzll(v));
+#else
+	std::size_t r = 0;
+	while (v >>= 1)
+	{
+		++r;
+	}
+	return r;
+#endif
+}
+
+} //namespace detail
+
+/*\class: concurrent_container
+ *\usage: Structure of arrays container for one writer thread appending rows while any amount of reader threads scan them, without locks.
+ *		  Rows are stored in segments that are never moved: segment k holds first_segment_rows * 2^k rows, so the segment of a row
+ *		  is found with one bit scan, and the segment table has a fixed size. The writer constructs all elements of a row, then
+ *		  publishes the new size with release semantics. Readers load the size with acquire semantics, and can then read all rows
+ *		  before it. Only one thread may call the modifiers at a time, and published rows must not be modified
+*/
+template<typename... Ts>
+class concurrent_container
+{
+	static_assert(sizeof...(Ts) > 0, "concurrent_container needs at least one column");
+
+public:
+	using const_iterator = multi_iterator<detail::source_column<concurrent_container const, std::add_const_t<Ts>>...>;
+	using iterator = const_iterator;
+	using value_type = detail::tuple_wrapper<Ts...>;
+	using const_reference = detail::tuple_wrapper<std::add_lvalue_reference_t<std::add_const_t<Ts>> ...>;
+	using reference = const_reference;
+	using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+	using size_type = std::size_t;
+	using difference_type = std::ptrdiff_t;
+
+	static constexpr size_type first_segment_rows = 1024;
+	static constexpr size_type max_segments = 48;
+
+	concurrent_container()
+	{
+	}
+
+	//Allocates all segments from resource, which is only used by the writer
+	explicit concurrent_container(std::pmr::memory_resource* resource) : m_resource(resource)
+	{
+	}
+
+	concurrent_container(concurrent_container const&) = delete;
+	concurrent_container& operator=(concurrent_container const&) = delete;
+
+	~concurrent_container()
+	{
+		clear();
+	}
+
+	//Iterators only reach the rows that were published when end() or cend() was called
+
+	const_iterator begin() const
+	{
+		return const_iterator(this, 0);
+	}
+
+	const_iterator end() const
+	{
+		return const_iterator(this, static_cast<difference_type>(size()));
+	}
+
+	const_iterator cbegin() const
+	{
+		return begin();
+	}
+
+	const_iterator cend() const
+	{
+		return end();
+	}
+
+	const_reverse_iterator crbegin() const
+	{
+		return const_reverse_iterator { end() };
+	}
+
+	const_reverse_iterator crend() const
+	{
+		return const_reverse_iterator { begin() };
+	}
+
+	//Returns a view over all rows published so far. It stays valid while new rows are appended
+	column_view<const_iterator> snapshot() const
+	{
+		size_type const n = size();
+		return column_view<const_iterator>(begin(), begin() + static_cast<difference_type>(n), n);
+	}
+
+	const_reference operator[](size_type index) const
+	{
+		dbg_assert((index < size()), "concurrent_container index out of range");
+		return const_reference { row(static_cast<difference_type>(index)) };
+	}
+
+	const_reference at(size_type index) const
+	{
+		if (index >= size())
+		{
+			throw std::out_of_range("concurrent_container index out of range");
+		}
+		return const_reference { row(static_cast<difference_type>(index)) };
+	}
+
+	const_reference front() const
+	{
+		return (*this)[0];
+	}
+
+	//Returns the last row that was published when back() was called
+	const_reference back() const
+	{
+		return (*this)[size() - 1];
+	}
+
+	//Returns references to the elements of row index, which must have been published. Used by the iterators
+	std::tuple<std::add_lvalue_reference_t<std::add_const_t<Ts>>...> row(difference_type index) const
+	{
+		size_type const k = segment_of(static_cast<size_type>(index));
+		size_type const offset = static_cast<size_type>(index) - segment_start(k);
+		return std::apply([offset](Ts*... columns) { return std::tuple<std::add_lvalue_reference_t<std::add_const_t<Ts>>...>(columns[offset]...); },
+			m_segments[k].columns);
+	}
+
+	//Amount of published rows. Every row before it is fully constructed and can be read without locks
+	size_type size() const
+	{
+		return m_size.load(std::memory_order_acquire);
+	}
+
+	bool empty() const
+	{
+		return size() == 0;
+	}
+
+	//Calls f(count, column pointers...) once for every segment holding rows that are published when for_each_segment() is called.
+	//The pointers are const, every call works on contiguous columns
+	template<typename F>
+	void for_each_segment(F f) const
+	{
+		size_type const n = size();
+		for (size_type k = 0; segment_start(k) < n; ++k)
+		{
+			size_type const count = std::min(n - segment_start(k), segment_rows(k));
+			std::apply([&f, count](Ts*... columns) { f(count, static_cast<std::add_const_t<Ts> const*>(columns)...); }, m_segments[k].columns);
+		}
+	}
+
+	//Modifiers, only the writer thread may call these
+
+	template<typename... Elems>
+	void push_back(std::tuple<Elems...> const& elems)
+	{
+		static_assert(sizeof...(Elems) == sizeof...(Ts), "Invalid argument count");
+		push_back_copy(elems, std::index_sequence_for<Ts...> {});
+	}
+
+	template<typename... Elems>
+	void push_back(std::tuple<Elems...>&& elems)
+	{
+		static_assert(sizeof...(Elems) == sizeof...(Ts), "Invalid argument count");
+		push_back_move(std::move(elems), std::index_sequence_for<Ts...> {});
+	}
+
+	//Every argument is a tuple holding the constructor arguments for the element of one column, see multi_vector::emplace_back.
+	//The row is visible to readers once all of its elements are constructed
+	template<typename... ArgTuples>
+	void emplace_back(ArgTuples&&... args)
+	{
+		static_assert(sizeof...(ArgTuples) == sizeof...(Ts), "Invalid argument count");
+
+		size_type const n = m_size.load(std::memory_order_relaxed);
+		size_type const k = segment_of(n);
+		if (n == segment_start(k))
+		{
+			if (k >= max_segments)
+			{
+				throw std::length_error("concurrent_container is full");
+			}
+			if (m_segments[k].data == nullptr)
+			{
+				m_segments[k] = allocate_segment(k, std::index_sequence_for<Ts...> {});
+			}
+		}
+		construct_row(m_segments[k], n - segment_start(k), std::index_sequence_for<Ts...> {}, std::forward<ArgTuples>(args)...);
+		m_size.store(n + 1, std::memory_order_release);
+	}
+
+	//Destroys all rows and frees all segments. There must be no readers
+	void clear()
+	{
+		size_type const n = m_size.load(std::memory_order_relaxed);
+		for (size_type k = 0; k < max_segments && m_segments[k].data != nullptr; ++k)
+		{
+			if (segment_start(k) < n)
+			{
+				destroy_rows(m_segments[k], std::min(n - segment_start(k), segment_rows(k)), std::index_sequence_for<Ts...> {});
+			}
+			m_resource->deallocate(m_segments[k].data, layout_type(segment_rows(k)).bytes, layout_type::alignment);
+			m_segments[k] = segment {};
+		}
+		m_size.store(0, std::memory_order_relaxed);
+	}
+
+private:
+	using layout_type = detail::soa_layout<Ts...>;
+
+	struct segment
+	{
+		void* data = nullptr;
+		std::tuple<Ts*...> columns {};
+	};
+
+	static size_type segment_rows(size_type k)
+	{
+		return first_segment_rows << k;
+	}
+
+	//Index of the first row in segment k
+	static size_type segment_start(size_type k)
+	{
+		return first_segment_rows * ((size_type(1) << k) - 1);
+	}
+
+	static size_type segment_of(size_type index)
+	{
+		return detail::floor_log2(index / first_segment_rows + 1);
+	}
+
+	template<std::size_t... Is>
+	segment allocate_segment(size_type k, std::index_sequence<Is...>)
+	{
+		layout_type const layout(segment_rows(k));
+		void* data = m_resource->allocate(layout.bytes, layout_type::alignment);
+		return segment { data, std::tuple<Ts*...> { reinterpret_cast<Ts*>(static_cast<char*>(data) + layout.offsets[Is]) ... } };
+	}
+
+	template<std::size_t... Is>
+	static void destroy_rows(segment const& s, size_type count, std::index_sequence<Is...>)
+	{
+		(std::destroy_n(std::get<Is>(s.columns), count), ...);
+	}
+
+	template<std::size_t I, typename Args>
+	static void construct_element(segment const& s, size_type offset, Args&& args)
+	{
+		using T = std::tuple_element_t<I, std::tuple<Ts...>>;
+		T* where = std::get<I>(s.columns) + offset;
+		std::apply([where](auto&&... a) { ::new (static_cast<void*>(where)) T(std::forward<decltype(a)>(a) ...); },
+			std::forward<Args>(args));
+	}
+
+	//Constructs the elements of a row from the argument tuples in args. If one of the constructors throws,
+	//the elements that were already constructed are destroyed again
+	template<std::size_t... Is, typename... ArgTuples>
+	static void construct_row(segment const& s, size_type offset, std::index_sequence<Is...>, ArgTuples&&... args)
+	{
+		std::size_t constructed = 0;
+		try
+		{
+			((construct_element<Is>(s, offset, std::forward<ArgTuples>(args)), ++constructed), ...);
+		}
+		catch (...)
+		{
+			((Is < constructed ? std::destroy_at(std::get<Is>(s.columns) + offset) : (void)0), ...);
+			throw;
+		}
+	}
+
+	template<typename... Elems, std::size_t... Is>
+	void push_back_copy(std::tuple<Elems...> const& elems, std::index_sequence<Is...>)
+	{
+		emplace_back(std::forward_as_tuple(std::get<Is>(elems)) ...);
+	}
+
+	template<typename... Elems, std::size_t... Is>
+	void push_back_move(std::tuple<Elems...>&& elems, std::index_sequence<Is...>)
+	{
+		emplace_back(std::forward_as_tuple(std::get<Is>(std::move(elems))) ...);
+	}
+
+	std::pmr::memory_resource* m_resource = std::pmr::get_default_resource();
+	//Only written by the writer before the first row of a segment is published, so readers can read it without atomics
+	std::array<segment, max_segments> m_segments {};
+	std::atomic<size_type> m_size { 0 };
+};
+
+} //namespace mvg
+
+#endif
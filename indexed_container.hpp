@@ -0,0 +1,427 @@
+#ifndef MVG_INDEXED_CONTAINER_HPP_
+#define MVG_INDEXED_CONTAINER_HPP_
+
+#include <tuple>
+#include <vector>
+#include <iterator>
+#include <functional>
+#include <limits>
+#include <stdexcept>
+#include <cstddef>
+#include <cstdint>
+
+#include "multi_container.hpp"
+
+namespace mvg
+{
+
+/*\class: basic_indexed_container
+ *\usage: multi_container<Ts...> with a hash index on the container at index I, for looking up rows by key in O(1)
+ *		  instead of searching them with std::find. The index is an open addressing table with linear probing, which stores
+ *		  the row number and the hash of every row. Appending and pop_back() update the index in place. Modifiers that move rows
+ *		  (insert, erase, sorting) rebuild it from the stored rows, which is O(n) like the modifiers themselves.
+ *		  Rows are only accessible as const, so the keys can't be changed behind the index. Use modify() to change rows directly.
+ *		  Several rows may have the same key
+*/
+template<std::size_t I, typename Hash, typename KeyEqual, typename... Ts>
+class basic_indexed_container
+{
+	static_assert(I < sizeof...(Ts), "Key index out of range");
+
+public:
+	using container_type = multi_container<Ts...>;
+	using key_type = detail::container_value_t<std::tuple_element_t<I, std::tuple<Ts...>>>;
+	using hasher = Hash;
+	using key_equal = KeyEqual;
+	using iterator = typename container_type::iterator;
+	using const_iterator = typename container_type::const_iterator;
+	using value_type = typename container_type::value_type;
+	using size_type = std::size_t;
+	using difference_type = std::ptrdiff_t;
+
+	static_assert(std::is_base_of_v<std::random_access_iterator_tag,
+		typename std::iterator_traits<typename std::tuple_element_t<I, std::tuple<Ts...>>::iterator>::iterator_category>,
+		"The key container must support random access");
+
+	//Returned by position() when no row has the key
+	static constexpr size_type npos = std::numeric_limits<size_type>::max();
+
+	basic_indexed_container()
+	{
+	}
+
+	explicit basic_indexed_container(container_type container, Hash hash = Hash {}, KeyEqual equal = KeyEqual {}) :
+		m_container(std::move(container)), m_hash(std::move(hash)), m_equal(std::move(equal))
+	{
+		rebuild();
+	}
+
+	const_iterator begin() const
+	{
+		return m_container.begin();
+	}
+
+	const_iterator end() const
+	{
+		return m_container.end();
+	}
+
+	const_iterator cbegin() const
+	{
+		return m_container.cbegin();
+	}
+
+	const_iterator cend() const
+	{
+		return m_container.cend();
+	}
+
+	auto operator[](size_type index) const
+	{
+		return m_container[index];
+	}
+
+	auto at(size_type index) const
+	{
+		return m_container.at(index);
+	}
+
+	auto front() const
+	{
+		return m_container.front();
+	}
+
+	auto back() const
+	{
+		return m_container.back();
+	}
+
+	size_type size() const
+	{
+		return m_count;
+	}
+
+	bool empty() const
+	{
+		return m_count == 0;
+	}
+
+	container_type const& container() const
+	{
+		return m_container;
+	}
+
+	//Lookup
+
+	//Returns the index of a row whose key is equal to key, or npos if there is none
+	size_type position(key_type const& key) const
+	{
+		if (m_count == 0)
+		{
+			return npos;
+		}
+		std::size_t const h = m_hash(key);
+		for (std::size_t i = bucket(h); m_slots[i].row != npos; i = (i + 1) & m_mask)
+		{
+			if (m_slots[i].hash == h && m_equal(key_at(m_slots[i].row), key))
+			{
+				return m_slots[i].row;
+			}
+		}
+		return npos;
+	}
+
+	//Returns an iterator to a row whose key is equal to key, or end() if there is none
+	const_iterator find(key_type const& key) const
+	{
+		size_type const row = position(key);
+		return row == npos ? end() : begin() + static_cast<difference_type>(row);
+	}
+
+	bool contains(key_type const& key) const
+	{
+		return position(key) != npos;
+	}
+
+	//Returns the amount of rows whose key is equal to key
+	size_type count(key_type const& key) const
+	{
+		if (m_count == 0)
+		{
+			return 0;
+		}
+		std::size_t const h = m_hash(key);
+		size_type n = 0;
+		for (std::size_t i = bucket(h); m_slots[i].row != npos; i = (i + 1) & m_mask)
+		{
+			if (m_slots[i].hash == h && m_equal(key_at(m_slots[i].row), key))
+			{
+				++n;
+			}
+		}
+		return n;
+	}
+
+	//Modifiers
+
+	void reserve(size_type n)
+	{
+		m_container.reserve(n);
+		reserve_slots(n);
+	}
+
+	void clear()
+	{
+		m_container.clear();
+		m_slots.clear();
+		m_mask = 0;
+		m_shift = 0;
+		m_count = 0;
+	}
+
+	template<typename... Elems>
+	void push_back(std::tuple<Elems...> const& elems)
+	{
+		reserve_slots(m_count + 1);
+		m_container.push_back(elems);
+		index_last();
+	}
+
+	template<typename... Elems>
+	void push_back(std::tuple<Elems...>&& elems)
+	{
+		reserve_slots(m_count + 1);
+		m_container.push_back(std::move(elems));
+		index_last();
+	}
+
+	//See multi_container::emplace_back
+	template<typename... ArgTuples>
+	void emplace_back(ArgTuples&&... args)
+	{
+		reserve_slots(m_count + 1);
+		m_container.emplace_back(std::forward<ArgTuples>(args)...);
+		index_last();
+	}
+
+	void pop_back()
+	{
+		dbg_assert((m_count > 0), "pop_back() on empty indexed_container");
+		unindex(m_count - 1);
+		m_container.pop_back();
+	}
+
+	template<typename... Elems>
+	const_iterator insert(const_iterator pos, std::tuple<Elems...> const& elems)
+	{
+		difference_type const index = pos - begin();
+		m_container.insert(pos, elems);
+		rebuild();
+		return begin() + index;
+	}
+
+	const_iterator erase(const_iterator pos)
+	{
+		difference_type const index = pos - begin();
+		m_container.erase(pos);
+		rebuild();
+		return begin() + index;
+	}
+
+	const_iterator erase(const_iterator first, const_iterator last)
+	{
+		difference_type const index = first - begin();
+		m_container.erase(first, last);
+		rebuild();
+		return begin() + index;
+	}
+
+	//See multi_container::remove_if_rows
+	template<typename Pred>
+	size_type remove_if_rows(Pred pred)
+	{
+		size_type const removed = m_container.remove_if_rows(pred);
+		if (removed > 0)
+		{
+			rebuild();
+		}
+		return removed;
+	}
+
+	//See multi_container::sort_by
+	template<std::size_t J, typename Compare = std::less<>>
+	void sort_by(Compare comp = Compare {})
+	{
+		m_container.template sort_by<J>(comp);
+		rebuild();
+	}
+
+	template<typename Proj, typename Compare = std::less<>>
+	void sort_by(Proj proj, Compare comp = Compare {})
+	{
+		m_container.sort_by(proj, comp);
+		rebuild();
+	}
+
+	//See multi_container::radix_sort_by
+	template<std::size_t J>
+	void radix_sort_by()
+	{
+		m_container.template radix_sort_by<J>();
+		rebuild();
+	}
+
+	//Calls f(container) with the container, then rebuilds the index. f may change the container in any way
+	template<typename F>
+	void modify(F f)
+	{
+		try
+		{
+			f(m_container);
+		}
+		catch (...)
+		{
+			rebuild();
+			throw;
+		}
+		rebuild();
+	}
+
+private:
+	struct slot
+	{
+		size_type row = npos;
+		std::size_t hash = 0;
+	};
+
+	key_type const& key_at(size_type row) const
+	{
+		return std::get<I>(m_container.data())[row];
+	}
+
+	//Returns the first slot to probe for hash h. The hash is multiplied with 2^64 / phi and the slot taken from the top bits
+	//of the product, so that hashes which only differ in their high bits, like the identity std::hash of integers
+	//with a large stride, don't all land in the same cluster
+	std::size_t bucket(std::size_t h) const
+	{
+		return static_cast<std::size_t>((static_cast<std::uint64_t>(h) * 0x9E3779B97F4A7C15ull) >> m_shift);
+	}
+
+	//Makes sure that n rows fit into the table while it is at most 3/4 full
+	void reserve_slots(size_type n)
+	{
+		if (n * 4 <= m_slots.size() * 3)
+		{
+			return;
+		}
+		std::size_t capacity = m_slots.empty() ? 16 : m_slots.size();
+		while (n * 4 > capacity * 3)
+		{
+			capacity *= 2;
+		}
+		int bits = 0;
+		while ((std::size_t(1) << bits) < capacity)
+		{
+			++bits;
+		}
+
+		std::vector<slot> old(capacity);
+		old.swap(m_slots);
+		m_mask = capacity - 1;
+		m_shift = 64 - bits;
+		for (slot const& s : old)
+		{
+			if (s.row != npos)
+			{
+				place(s);
+			}
+		}
+	}
+
+	void place(slot s)
+	{
+		std::size_t i = bucket(s.hash);
+		while (m_slots[i].row != npos)
+		{
+			i = (i + 1) & m_mask;
+		}
+		m_slots[i] = s;
+	}
+
+	//Adds the last row of the container to the index. The table must have room for it.
+	//If the hash function throws, the row is removed again
+	void index_last()
+	{
+		size_type const row = m_count;
+		std::size_t h;
+		try
+		{
+			h = m_hash(key_at(row));
+		}
+		catch (...)
+		{
+			m_container.pop_back();
+			throw;
+		}
+		place(slot { row, h });
+		++m_count;
+	}
+
+	//Removes the slot of row from the index, and moves the following slots of its cluster back
+	//so that no lookup stops early at the freed slot
+	void unindex(size_type row)
+	{
+		std::size_t i = bucket(m_hash(key_at(row)));
+		while (m_slots[i].row != row)
+		{
+			i = (i + 1) & m_mask;
+		}
+
+		for (std::size_t j = (i + 1) & m_mask; m_slots[j].row != npos; j = (j + 1) & m_mask)
+		{
+			std::size_t const home = bucket(m_slots[j].hash);
+			//The slot at j can move to i unless its home lies cyclically in ]i, j]
+			bool const stays = i <= j ? (i < home && home <= j) : (i < home || home <= j);
+			if (!stays)
+			{
+				m_slots[i] = m_slots[j];
+				i = j;
+			}
+		}
+		m_slots[i] = slot {};
+		--m_count;
+	}
+
+	void rebuild()
+	{
+		size_type const n = m_container.size();
+		m_slots.clear();
+		m_mask = 0;
+		m_shift = 0;
+		m_count = 0;
+		reserve_slots(n);
+		for (size_type row = 0; row < n; ++row)
+		{
+			place(slot { row, m_hash(key_at(row)) });
+			++m_count;
+		}
+	}
+
+	container_type m_container;
+	Hash m_hash;
+	KeyEqual m_equal;
+	std::vector<slot> m_slots;
+	std::size_t m_mask = 0;
+	//64 - log2 of the table size
+	int m_shift = 0;
+	size_type m_count = 0;
+};
+
+template<std::size_t I, typename... Ts>
+using indexed_container = basic_indexed_container<I,
+	std::hash<detail::container_value_t<std::tuple_element_t<I, std::tuple<Ts...>>>>,
+	std::equal_to<detail::container_value_t<std::tuple_element_t<I, std::tuple<Ts...>>>>, Ts...>;
+
+} //namespace mvg
+
+#endif
@@ -0,0 +1,219 @@
+#ifndef MVG_INSTRUMENTATION_HPP_
+#define MVG_INSTRUMENTATION_HPP_
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+
+/*When MVG_INSTRUMENTATION is defined to 1, multi_container and multi_iterator count how often their operations are called,
+ *and how long push_back, insert, erase, emplace and remove_if take. The counters are process wide and updated with relaxed atomics.
+ *When it is 0 (the default), all instrumentation compiles to nothing.
+ *It must be defined to the same value in every translation unit*/
+#ifndef MVG_INSTRUMENTATION
+#define MVG_INSTRUMENTATION 0
+#endif
+
+namespace mvg
+{
+
+//Reallocations are counted per column index, columns past this index are counted in the last slot
+static constexpr std::size_t stats_max_columns = 16;
+
+/*Snapshot of the instrumentation counters, returned by mvg::stats(). Times are in nanoseconds*/
+struct stats_snapshot
+{
+	std::uint64_t push_back = 0;
+	std::uint64_t push_back_ns = 0;
+	std::uint64_t insert = 0;
+	std::uint64_t insert_ns = 0;
+	std::uint64_t erase = 0;
+	std::uint64_t erase_ns = 0;
+	std::uint64_t emplace = 0;
+	std::uint64_t emplace_ns = 0;
+	std::uint64_t remove_if = 0;
+	std::uint64_t remove_if_ns = 0;
+	std::uint64_t size = 0;
+	std::uint64_t iterator_advance = 0;
+	std::uint64_t iterator_compare = 0;
+	std::array<std::uint64_t, stats_max_columns> reallocations {};
+};
+
+using stats_hook = void(*)(stats_snapshot const&);
+
+namespace detail
+{
+
+enum class stat_counter
+{
+	push_back,
+	insert,
+	erase,
+	emplace,
+	remove_if,
+	size,
+	iterator_advance,
+	iterator_compare,
+	count
+};
+
+struct stats_storage
+{
+	std::array<std::atomic<std::uint64_t>, static_cast<std::size_t>(stat_counter::count)> counters {};
+	std::array<std::atomic<std::uint64_t>, static_cast<std::size_t>(stat_counter::count)> nanoseconds {};
+	std::array<std::atomic<std::uint64_t>, stats_max_columns> reallocations {};
+	std::atomic<stats_hook> hook { nullptr };
+};
+
+inline stats_storage& global_stats()
+{
+	static stats_storage storage;
+	return storage;
+}
+
+/*Instrumentation policy. The disabled version has only empty inline functions and empty scope types*/
+template<bool Enabled>
+struct instrumentation
+{
+	struct scope_timer
+	{
+	};
+
+	static void count([[maybe_unused]] stat_counter c)
+	{
+	}
+
+	static void reallocation([[maybe_unused]] std::size_t column)
+	{
+	}
+
+	static scope_timer time([[maybe_unused]] stat_counter c)
+	{
+		return {};
+	}
+};
+
+template<>
+struct instrumentation<true>
+{
+	//Counts one call of c, and adds the time until it is destroyed to the time of c
+	struct scope_timer
+	{
+		stat_counter counter;
+		std::chrono::steady_clock::time_point start;
+
+		~scope_timer()
+		{
+			auto ns = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count();
+			global_stats().nanoseconds[static_cast<std::size_t>(counter)].fetch_add(static_cast<std::uint64_t>(ns), std::memory_order_relaxed);
+		}
+	};
+
+	static void count(stat_counter c)
+	{
+		global_stats().counters[static_cast<std::size_t>(c)].fetch_add(1, std::memory_order_relaxed);
+	}
+
+	static void reallocation(std::size_t column)
+	{
+		std::size_t const slot = column < stats_max_columns ? column : stats_max_columns - 1;
+		global_stats().reallocations[slot].fetch_add(1, std::memory_order_relaxed);
+	}
+
+	static scope_timer time(stat_counter c)
+	{
+		count(c);
+		return scope_timer { c, std::chrono::steady_clock::now() };
+	}
+};
+
+using instr = instrumentation<MVG_INSTRUMENTATION>;
+
+} //namespace detail
+
+//Returns the current value of all counters. All counters are 0 when MVG_INSTRUMENTATION is 0
+inline stats_snapshot stats()
+{
+	using detail::stat_counter;
+
+	detail::stats_storage const& s = detail::global_stats();
+	auto counter = [&s](stat_counter c) { return s.counters[static_cast<std::size_t>(c)].load(std::memory_order_relaxed); };
+	auto ns = [&s](stat_counter c) { return s.nanoseconds[static_cast<std::size_t>(c)].load(std::memory_order_relaxed); };
+
+	stats_snapshot snapshot;
+	snapshot.push_back = counter(stat_counter::push_back);
+	snapshot.push_back_ns = ns(stat_counter::push_back);
+	snapshot.insert = counter(stat_counter::insert);
+	snapshot.insert_ns = ns(stat_counter::insert);
+	snapshot.erase = counter(stat_counter::erase);
+	snapshot.erase_ns = ns(stat_counter::erase);
+	snapshot.emplace = counter(stat_counter::emplace);
+	snapshot.emplace_ns = ns(stat_counter::emplace);
+	snapshot.remove_if = counter(stat_counter::remove_if);
+	snapshot.remove_if_ns = ns(stat_counter::remove_if);
+	snapshot.size = counter(stat_counter::size);
+	snapshot.iterator_advance = counter(stat_counter::iterator_advance);
+	snapshot.iterator_compare = counter(stat_counter::iterator_compare);
+	for (std::size_t i = 0; i < stats_max_columns; ++i)
+	{
+		snapshot.reallocations[i] = s.reallocations[i].load(std::memory_order_relaxed);
+	}
+	return snapshot;
+}
+
+//Sets all counters to 0
+inline void reset_stats()
+{
+	detail::stats_storage& s = detail::global_stats();
+	for (auto& c : s.counters)
+	{
+		c.store(0, std::memory_order_relaxed);
+	}
+	for (auto& c : s.nanoseconds)
+	{
+		c.store(0, std::memory_order_relaxed);
+	}
+	for (auto& c : s.reallocations)
+	{
+		c.store(0, std::memory_order_relaxed);
+	}
+}
+
+//Sets the function called by dump_stats(). Passing nullptr restores the default, which prints to stderr
+inline void set_stats_hook(stats_hook hook)
+{
+	detail::global_stats().hook.store(hook);
+}
+
+//Passes a snapshot of all counters to the hook set with set_stats_hook(), or prints it to stderr when there is none
+inline void dump_stats()
+{
+	stats_snapshot const snapshot = stats();
+	if (stats_hook hook = detail::global_stats().hook.load())
+	{
+		hook(snapshot);
+		return;
+	}
+
+	std::fprintf(stderr, "mvg stats: push_back %llu (%llu ns), insert %llu (%llu ns), erase %llu (%llu ns), "
+		"emplace %llu (%llu ns), remove_if %llu (%llu ns), size %llu, "
+		"iterator advance %llu, iterator compare %llu\nmvg stats: reallocations per column:",
+		static_cast<unsigned long long>(snapshot.push_back), static_cast<unsigned long long>(snapshot.push_back_ns),
+		static_cast<unsigned long long>(snapshot.insert), static_cast<unsigned long long>(snapshot.insert_ns),
+		static_cast<unsigned long long>(snapshot.erase), static_cast<unsigned long long>(snapshot.erase_ns),
+		static_cast<unsigned long long>(snapshot.emplace), static_cast<unsigned long long>(snapshot.emplace_ns),
+		static_cast<unsigned long long>(snapshot.remove_if), static_cast<unsigned long long>(snapshot.remove_if_ns),
+		static_cast<unsigned long long>(snapshot.size), static_cast<unsigned long long>(snapshot.iterator_advance),
+		static_cast<unsigned long long>(snapshot.iterator_compare));
+	for (std::uint64_t r : snapshot.reallocations)
+	{
+		std::fprintf(stderr, " %llu", static_cast<unsigned long long>(r));
+	}
+	std::fprintf(stderr, "\n");
+}
+
+} //namespace mvg
+
+#endif
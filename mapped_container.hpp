@@ -0,0 +1,387 @@
+#ifndef MVG_MAPPED_CONTAINER_HPP_
+#define MVG_MAPPED_CONTAINER_HPP_
+
+#include <tuple>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <stdexcept>
+#include <utility>
+
+#if defined(_WIN32)
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#include "multi_iterator.hpp"
+#include "column_file.hpp"
+#include "column_kernels.hpp"
+#include "column_view.hpp"
+
+namespace mvg
+{
+
+namespace detail
+{
+
+/*Read only mapping of a whole file. The pages are shared with every other process mapping the same file*/
+class file_mapping
+{
+public:
+	file_mapping()
+	{
+	}
+
+	explicit file_mapping(std::filesystem::path const& path)
+	{
+#if defined(_WIN32)
+		HANDLE file = CreateFileW(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+		if (file == INVALID_HANDLE_VALUE)
+		{
+			throw std::runtime_error("Can't open file for reading");
+		}
+		LARGE_INTEGER size;
+		if (!GetFileSizeEx(file, &size))
+		{
+			CloseHandle(file);
+			throw std::runtime_error("Can't get file size");
+		}
+		m_size = static_cast<std::size_t>(size.QuadPart);
+		if (m_size > 0)
+		{
+			HANDLE mapping = CreateFileMappingW(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+			if (mapping != nullptr)
+			{
+				m_data = static_cast<std::byte const*>(MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0));
+				CloseHandle(mapping);
+			}
+		}
+		CloseHandle(file);
+#else
+		int fd = ::open(path.c_str(), O_RDONLY);
+		if (fd < 0)
+		{
+			throw std::runtime_error("Can't open file for reading");
+		}
+		struct stat st;
+		if (::fstat(fd, &st) != 0)
+		{
+			::close(fd);
+			throw std::runtime_error("Can't get file size");
+		}
+		m_size = static_cast<std::size_t>(st.st_size);
+		if (m_size > 0)
+		{
+			void* data = ::mmap(nullptr, m_size, PROT_READ, MAP_SHARED, fd, 0);
+			m_data = data == MAP_FAILED ? nullptr : static_cast<std::byte const*>(data);
+		}
+		::close(fd);
+#endif
+		if (m_size > 0 && m_data == nullptr)
+		{
+			throw std::runtime_error("Can't map file");
+		}
+	}
+
+	file_mapping(file_mapping const&) = delete;
+	file_mapping& operator=(file_mapping const&) = delete;
+
+	file_mapping(file_mapping&& rhs) noexcept
+	{
+		swap(rhs);
+	}
+
+	file_mapping& operator=(file_mapping&& rhs) noexcept
+	{
+		file_mapping moved { std::move(rhs) };
+		swap(moved);
+		return *this;
+	}
+
+	~file_mapping()
+	{
+		if (m_data != nullptr)
+		{
+#if defined(_WIN32)
+			UnmapViewOfFile(m_data);
+#else
+			::munmap(const_cast<std::byte*>(m_data), m_size);
+#endif
+		}
+	}
+
+	void swap(file_mapping& rhs) noexcept
+	{
+		std::swap(m_data, rhs.m_data);
+		std::swap(m_size, rhs.m_size);
+	}
+
+	std::byte const* data() const
+	{
+		return m_data;
+	}
+
+	std::size_t size() const
+	{
+		return m_size;
+	}
+
+private:
+	std::byte const* m_data = nullptr;
+	std::size_t m_size = 0;
+};
+
+} //namespace detail
+
+/*\class: mapped_container
+ *\usage: Read only view over a file written by multi_container::save() or multi_vector::save(), returned by mvg::load_mmap().
+ *		  The columns point directly into the mapped file, nothing is copied. Opening is O(number of columns),
+ *		  pages are loaded on first access and shared between all processes that map the same file.
+ *		  Iterating gives the same const multi_iterator and tuple_wrapper rows as a const multi_vector
+*/
+template<typename... Ts>
+class mapped_container
+{
+	static_assert(sizeof...(Ts) > 0, "mapped_container needs at least one column");
+	static_assert((std::is_trivially_copyable_v<Ts> && ...), "Only trivially copyable columns can be mapped");
+	static_assert(((alignof(Ts) <= detail::column_file_alignment) && ...), "Column alignment is larger than the file alignment");
+
+public:
+	using iterator = multi_iterator<detail::indexed_column<std::add_const_t<Ts>>...>;
+	using const_iterator = iterator;
+	using value_type = detail::tuple_wrapper<Ts...>;
+	using reference = detail::tuple_wrapper<std::add_lvalue_reference_t<std::add_const_t<Ts>> ...>;
+	using const_reference = reference;
+	using reverse_iterator = std::reverse_iterator<iterator>;
+	using const_reverse_iterator = reverse_iterator;
+	using size_type = std::size_t;
+	using difference_type = std::ptrdiff_t;
+
+	//Maps the file at path. Throws std::runtime_error when the file can't be mapped, or doesn't hold columns of types Ts...
+	explicit mapped_container(std::filesystem::path const& path) : m_mapping(path)
+	{
+		std::byte const* base = m_mapping.data();
+		std::size_t const file_size = m_mapping.size();
+
+		detail::column_file_header header;
+		if (file_size < sizeof(header))
+		{
+			throw std::runtime_error("File is too small to be a column file");
+		}
+		std::memcpy(&header, base, sizeof(header));
+		if (std::memcmp(header.magic, detail::column_file_magic, sizeof(header.magic)) != 0)
+		{
+			throw std::runtime_error("File is not a column file");
+		}
+		if (header.version != detail::column_file_version)
+		{
+			throw std::runtime_error("Column file has an unsupported version");
+		}
+		if (header.endian != detail::column_file_endian)
+		{
+			throw std::runtime_error("Column file was written with a different byte order");
+		}
+		if (header.column_count != sizeof...(Ts))
+		{
+			throw std::runtime_error("Column file has a different amount of columns");
+		}
+
+		detail::column_file_column descs[sizeof...(Ts)];
+		if (file_size < sizeof(header) + sizeof(descs))
+		{
+			throw std::runtime_error("Column file is truncated");
+		}
+		std::memcpy(descs, base + sizeof(header), sizeof(descs));
+
+		m_size = static_cast<size_type>(header.row_count);
+		m_columns = map_columns(descs, std::index_sequence_for<Ts...> {});
+	}
+
+	//A moved from mapped_container is empty: it has no rows, null column pointers and no mapping
+	mapped_container(mapped_container&& rhs) noexcept
+		: m_mapping(std::move(rhs.m_mapping)), m_columns(std::exchange(rhs.m_columns, {})), m_size(std::exchange(rhs.m_size, 0))
+	{
+	}
+
+	mapped_container& operator=(mapped_container&& rhs) noexcept
+	{
+		if (this != &rhs)
+		{
+			m_mapping = std::move(rhs.m_mapping);
+			m_columns = std::exchange(rhs.m_columns, {});
+			m_size = std::exchange(rhs.m_size, 0);
+		}
+		return *this;
+	}
+
+	iterator begin() const
+	{
+		return make_iterator(0, std::index_sequence_for<Ts...> {});
+	}
+
+	iterator end() const
+	{
+		return make_iterator(static_cast<difference_type>(m_size), std::index_sequence_for<Ts...> {});
+	}
+
+	const_iterator cbegin() const
+	{
+		return begin();
+	}
+
+	const_iterator cend() const
+	{
+		return end();
+	}
+
+	const_reverse_iterator crbegin() const
+	{
+		return const_reverse_iterator { end() };
+	}
+
+	const_reverse_iterator crend() const
+	{
+		return const_reverse_iterator { begin() };
+	}
+
+	const_reference operator[](size_type index) const
+	{
+		dbg_assert((index < m_size), "mapped_container index out of range");
+		return begin()[index];
+	}
+
+	const_reference at(size_type index) const
+	{
+		if (index >= m_size)
+		{
+			throw std::out_of_range("mapped_container index out of range");
+		}
+		return begin()[index];
+	}
+
+	const_reference front() const
+	{
+		return *begin();
+	}
+
+	const_reference back() const
+	{
+		return begin()[m_size - 1];
+	}
+
+	//Returns a pointer to the first element of the column at index I, which points into the mapped file
+	template<std::size_t I>
+	std::add_pointer_t<std::add_const_t<std::tuple_element_t<I, std::tuple<Ts...>>>> data() const
+	{
+		return std::get<I>(m_columns);
+	}
+
+	//Returns a column_view over the columns at the indices Is
+	template<std::size_t... Is>
+	column_view<multi_iterator<detail::indexed_column<std::add_const_t<std::tuple_element_t<Is, std::tuple<Ts...>>>>...>> columns() const
+	{
+		using It = multi_iterator<detail::indexed_column<std::add_const_t<std::tuple_element_t<Is, std::tuple<Ts...>>>>...>;
+		return { It(std::get<Is>(m_columns)..., 0), It(std::get<Is>(m_columns)..., static_cast<difference_type>(m_size)), m_size };
+	}
+
+	//Calls f(spans...) for every batch of W rows, with a batch_span per column, see multi_container::for_each_batch
+	template<std::size_t W, typename F>
+	void for_each_batch(F f) const
+	{
+		std::apply([this, &f](auto... columns)
+		{
+			detail::for_each_batch<W>(m_size, f, columns...);
+		}, m_columns);
+	}
+
+	//Column kernels, see multi_container
+	template<std::size_t I>
+	auto sum() const
+	{
+		return detail::column_sum(data<I>(), m_size);
+	}
+
+	template<std::size_t I>
+	auto min_max() const
+	{
+		dbg_assert((m_size > 0), "min_max() on empty mapped_container");
+		return detail::column_min_max(data<I>(), m_size);
+	}
+
+	template<std::size_t I, std::size_t J>
+	auto dot() const
+	{
+		return detail::column_dot(data<I>(), data<J>(), m_size);
+	}
+
+	template<std::size_t I, std::size_t M, typename OutputIt>
+	OutputIt masked_select(OutputIt out) const
+	{
+		return detail::column_masked_select(data<I>(), data<M>(), m_size, out);
+	}
+
+	bool empty() const
+	{
+		return m_size == 0;
+	}
+
+	size_type size() const
+	{
+		return m_size;
+	}
+
+private:
+	template<std::size_t... Is>
+	iterator make_iterator(difference_type index, std::index_sequence<Is...>) const
+	{
+		return iterator(std::get<Is>(m_columns)..., index);
+	}
+
+	template<std::size_t... Is>
+	std::tuple<Ts const*...> map_columns(detail::column_file_column const* descs, std::index_sequence<Is...>) const
+	{
+		return std::tuple<Ts const*...> { map_column<Ts>(descs[Is]) ... };
+	}
+
+	template<typename T>
+	T const* map_column(detail::column_file_column const& desc) const
+	{
+		if (desc.type_tag != detail::column_type_tag<T>() || desc.type_id != column_type_id_v<T> || desc.element_size != sizeof(T) ||
+			desc.element_alignment != alignof(T))
+		{
+			throw std::runtime_error("Column file column has a different type");
+		}
+		if (m_size > m_mapping.size() / sizeof(T) || desc.bytes != m_size * sizeof(T) || desc.offset % detail::column_file_alignment != 0 ||
+			desc.offset > m_mapping.size() || desc.bytes > m_mapping.size() - desc.offset)
+		{
+			throw std::runtime_error("Column file is truncated");
+		}
+		return reinterpret_cast<T const*>(m_mapping.data() + desc.offset);
+	}
+
+	detail::file_mapping m_mapping;
+	std::tuple<Ts const*...> m_columns;
+	size_type m_size = 0;
+};
+
+//Maps a file written by multi_container::save() or multi_vector::save(), holding columns of types Ts...
+template<typename... Ts>
+mapped_container<Ts...> load_mmap(std::filesystem::path const& path)
+{
+	return mapped_container<Ts...>(path);
+}
+
+} //namespace mvg
+
+#endif
@@ -5,9 +5,25 @@
 #include <iterator>
 #include <limits>
 #include <initializer_list>
+#include <functional>
+#include <algorithm>
+#include <numeric>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <vector>
+#include <array>
 
 #include "multi_iterator.hpp"
 
+/*When MVG_CACHE_SIZE is defined to 1, mvg::multi_container keeps track of its size, which makes size() O(1).
+ *In this mode the size of the stored containers must only be changed through the multi_container itself,
+ *not through data() or get_container(). In debug builds, size() checks that all containers agree.
+ *It must be defined to the same value in every translation unit*/
+#ifndef MVG_CACHE_SIZE
+#define MVG_CACHE_SIZE 0
+#endif
+
 namespace mvg
 {
 
@@ -50,6 +66,339 @@ struct underlying_const_iterator<T[N]>
 	using type = std::add_const_t<std::add_pointer_t<T>>;
 };
 
+/*Type trait to check if a container stores its elements contiguously, meaning its elements
+ *can be addressed through a pointer to the first element and an index*/
+template<typename T>
+struct is_contiguous_container : public std::false_type {};
+
+template<typename T, typename Alloc>
+struct is_contiguous_container<std::vector<T, Alloc>> : public std::true_type {};
+
+//std::vector<bool> is packed, and has no data() member
+template<typename Alloc>
+struct is_contiguous_container<std::vector<bool, Alloc>> : public std::false_type {};
+
+template<typename T, std::size_t N>
+struct is_contiguous_container<std::array<T, N>> : public std::true_type {};
+
+template<typename T, std::size_t N>
+struct is_contiguous_container<T[N]> : public std::true_type {};
+
+template<typename T>
+static constexpr bool is_contiguous_container_v = is_contiguous_container<T>::value;
+
+template<typename T>
+using contiguous_element_t = std::remove_pointer_t<decltype(std::data(std::declval<T&>()))>;
+
+template<typename T>
+using container_value_t = typename std::iterator_traits<decltype(std::begin(std::declval<T&>()))>::value_type;
+
+/*Selects the iterator types of mvg::multi_container. When all containers are contiguous, the index based
+ *multi_iterator specialization is used. Otherwise the iterator stores one underlying iterator per container*/
+template<bool Contiguous, typename... Ts>
+struct container_iterator
+{
+	using type = multi_iterator<typename underlying_iterator<Ts>::type ...>;
+	using const_type = multi_iterator<typename underlying_const_iterator<Ts>::type ...>;
+};
+
+template<typename... Ts>
+struct container_iterator<true, Ts...>
+{
+	using type = multi_iterator<indexed_column<contiguous_element_t<Ts>>...>;
+	using const_type = multi_iterator<indexed_column<std::add_const_t<contiguous_element_t<Ts>>>...>;
+};
+
+template<typename... Ts>
+using container_iterator_t = container_iterator<(sizeof...(Ts) > 0) && (is_contiguous_container_v<Ts> && ...), Ts...>;
+
+/*Creates an iterator of type It to the beginning of all containers in conts*/
+template<typename It, typename Tpl>
+It make_begin(Tpl& conts)
+{
+	if constexpr (is_indexed_iterator_v<It>)
+	{
+		return std::apply([](auto&... c) { return It(std::data(c) ..., 0); }, conts);
+	}
+	else
+	{
+		return std::apply([](auto&... c) { return It(std::begin(c) ...); }, conts);
+	}
+}
+
+/*Creates an iterator of type It to the end of all containers in conts. The index based iterator
+ *has one shared index, so it ends at the size of the smallest container*/
+template<typename It, typename Tpl>
+It make_end(Tpl& conts, std::size_t size)
+{
+	if constexpr (is_indexed_iterator_v<It>)
+	{
+		return std::apply([size](auto&... c) 
+			{ return It(std::data(c) ..., static_cast<typename It::difference_type>(size)); }, conts);
+	}
+	else
+	{
+		return std::apply([](auto&... c) { return It(std::end(c) ...); }, conts);
+	}
+}
+
+/*Returns the iterator into container cont (which is the container at index I) that pos points to*/
+template<std::size_t I, typename C, typename It>
+auto container_position(C& cont, It const& pos)
+{
+	if constexpr (is_indexed_iterator_v<It>)
+	{
+		return std::next(std::begin(cont), pos.index());
+	}
+	else
+	{
+		return pos.template get_iterator<I>();
+	}
+}
+
+/*Rebuilds an iterator of type It from the underlying iterators returned by the containers in conts*/
+template<typename It, typename Tpl, typename First, typename... Rest>
+It rebuild_iterator(Tpl& conts, First first, Rest... rest)
+{
+	if constexpr (is_indexed_iterator_v<It>)
+	{
+		auto index = std::distance(std::begin(std::get<0>(conts)), first);
+		return std::apply([index](auto&... c) { return It(std::data(c) ..., index); }, conts);
+	}
+	else
+	{
+		return It(first, rest...);
+	}
+}
+
+/*Returns a std::tuple holding the underlying iterator of every column of the multi_iterator it*/
+template<typename It, std::size_t... Is>
+auto column_iterators(It const& it, std::index_sequence<Is...>)
+{
+	return std::make_tuple(it.template get_iterator<Is>() ...);
+}
+
+template<typename It>
+auto column_iterators(It const& it)
+{
+	return column_iterators(it, std::make_index_sequence<std::tuple_size_v<typename It::reference>> {});
+}
+
+/*Reorders the first perm.size() elements of cont so that the element at position i is the element that was at position perm[i].
+ *The elements are gathered in one pass into a buffer, and then moved back. When Apply is false, nothing happens*/
+template<bool Apply, typename C>
+void permute_container(C& cont, std::vector<std::size_t> const& perm)
+{
+	if constexpr (Apply)
+	{
+		using T = typename std::iterator_traits<decltype(std::begin(cont))>::value_type;
+		using It = decltype(std::begin(cont));
+
+		std::vector<T> sorted;
+		sorted.reserve(perm.size());
+		if constexpr (std::is_base_of_v<std::random_access_iterator_tag, typename std::iterator_traits<It>::iterator_category>)
+		{
+			It first = std::begin(cont);
+			for (std::size_t p : perm)
+			{
+				sorted.push_back(std::move(first[p]));
+			}
+		}
+		else
+		{
+			std::vector<It> its;
+			its.reserve(perm.size());
+			for (It it = std::begin(cont); its.size() < perm.size(); ++it)
+			{
+				its.push_back(it);
+			}
+			for (std::size_t p : perm)
+			{
+				sorted.push_back(std::move(*its[p]));
+			}
+		}
+		std::move(sorted.begin(), sorted.end(), std::begin(cont));
+	}
+}
+
+/*Applies perm to all containers in conts, except the one at index Skip*/
+template<std::size_t Skip, typename Tpl, std::size_t... Is>
+void permute_containers(Tpl& conts, std::vector<std::size_t> const& perm, std::index_sequence<Is...>)
+{
+	(permute_container<Is != Skip>(std::get<Is>(conts), perm), ...);
+}
+
+/*Sorts a vector of (key, index) pairs by key, and returns the indices in sorted order*/
+template<typename K, typename Compare>
+std::vector<std::size_t> sort_keys(std::vector<std::pair<K, std::size_t>>& keys, Compare& comp)
+{
+	std::sort(keys.begin(), keys.end(), 
+		[&comp](auto const& a, auto const& b) { return comp(a.first, b.first); });
+
+	std::vector<std::size_t> perm;
+	perm.reserve(keys.size());
+	for (auto const& key : keys)
+	{
+		perm.push_back(key.second);
+	}
+	return perm;
+}
+
+/*Returns the positions of the first n elements of cont in the order given by comp. cont is left unchanged if comp throws:
+ *trivially copyable elements are copied next to their position and sorted together with it, so the sort doesn't
+ *have to look up every element it compares. Other elements are compared where they are, through a vector of iterators
+ *if cont isn't random access*/
+template<typename C, typename Compare>
+std::vector<std::size_t> sort_positions(C const& cont, std::size_t n, Compare& comp)
+{
+	using It = decltype(std::begin(cont));
+	using T = typename std::iterator_traits<It>::value_type;
+
+	if constexpr (std::is_trivially_copyable_v<T>)
+	{
+		std::vector<std::pair<T, std::size_t>> keys;
+		keys.reserve(n);
+		It it = std::begin(cont);
+		for (std::size_t i = 0; i < n; ++i, ++it)
+		{
+			keys.emplace_back(*it, i);
+		}
+		return sort_keys(keys, comp);
+	}
+	else
+	{
+		std::vector<std::size_t> perm(n);
+		std::iota(perm.begin(), perm.end(), std::size_t(0));
+		if constexpr (std::is_base_of_v<std::random_access_iterator_tag, typename std::iterator_traits<It>::iterator_category>)
+		{
+			It const first = std::begin(cont);
+			std::sort(perm.begin(), perm.end(), [&comp, &first](std::size_t a, std::size_t b) { return comp(first[a], first[b]); });
+		}
+		else
+		{
+			std::vector<It> its;
+			its.reserve(n);
+			for (It it = std::begin(cont); its.size() < n; ++it)
+			{
+				its.push_back(it);
+			}
+			std::sort(perm.begin(), perm.end(), [&comp, &its](std::size_t a, std::size_t b) { return comp(*its[a], *its[b]); });
+		}
+		return perm;
+	}
+}
+
+/*Maps an arithmetic value to an unsigned integer with the same ordering, so it can be radix sorted.
+ *Signed integers get their sign bit flipped. Negative floating point numbers get all bits flipped,
+ *positive ones only their sign bit. -0.0 is mapped like +0.0, so they keep their order like with operator<,
+ *and all NaNs get the largest key, so they end up after +infinity whatever their sign and payload*/
+template<typename T>
+auto radix_key(T value)
+{
+	static_assert(std::is_arithmetic_v<T> && sizeof(T) <= sizeof(std::uint64_t) && !std::is_same_v<T, long double>,
+		"radix keys must be integral, float or double");
+
+	if constexpr (std::is_same_v<T, bool>)
+	{
+		return static_cast<std::uint8_t>(value);
+	}
+	else if constexpr (std::is_integral_v<T>)
+	{
+		using U = std::make_unsigned_t<T>;
+		U key = static_cast<U>(value);
+		if constexpr (std::is_signed_v<T>)
+		{
+			key ^= static_cast<U>(U(1) << (sizeof(T) * 8 - 1));
+		}
+		return key;
+	}
+	else
+	{
+		using U = std::conditional_t<sizeof(T) == sizeof(std::uint32_t), std::uint32_t, std::uint64_t>;
+		if (value != value)
+		{
+			return std::numeric_limits<U>::max();
+		}
+		if (value == T(0))
+		{
+			value = T(0);
+		}
+		U key;
+		std::memcpy(&key, &value, sizeof(T));
+		U const sign = U(1) << (sizeof(T) * 8 - 1);
+		return (key & sign) ? static_cast<U>(~key) : static_cast<U>(key | sign);
+	}
+}
+
+/*Stable LSD radix sort over the bytes of keys. Returns the indices of the keys in sorted order.
+ *The histograms of all bytes are computed in one pass, and passes where all keys have the same byte are skipped*/
+template<typename U>
+std::vector<std::size_t> radix_sort_permutation(std::vector<U>& keys)
+{
+	constexpr std::size_t passes = sizeof(U);
+	std::size_t const n = keys.size();
+
+	std::vector<std::array<std::size_t, 256>> counts(passes);
+	for (U key : keys)
+	{
+		for (std::size_t p = 0; p < passes; ++p)
+		{
+			++counts[p][(key >> (p * 8)) & 0xFF];
+		}
+	}
+
+	std::vector<std::size_t> perm(n);
+	for (std::size_t i = 0; i < n; ++i)
+	{
+		perm[i] = i;
+	}
+
+	std::vector<U> keys_tmp(n);
+	std::vector<std::size_t> perm_tmp(n);
+	for (std::size_t p = 0; p < passes; ++p)
+	{
+		std::array<std::size_t, 256>& count = counts[p];
+		if (std::find(count.begin(), count.end(), n) != count.end())
+		{
+			continue;
+		}
+
+		std::size_t offset = 0;
+		for (std::size_t& c : count)
+		{
+			std::size_t const bucket = c;
+			c = offset;
+			offset += bucket;
+		}
+
+		for (std::size_t i = 0; i < n; ++i)
+		{
+			std::size_t const pos = count[(keys[i] >> (p * 8)) & 0xFF]++;
+			keys_tmp[pos] = keys[i];
+			perm_tmp[pos] = perm[i];
+		}
+		keys.swap(keys_tmp);
+		perm.swap(perm_tmp);
+	}
+	return perm;
+}
+
+/*Constructs a container of type T that allocates from resource, if T is allocator aware and its allocator can be
+ *constructed from a Resource*, like a std::pmr::polymorphic_allocator from a std::pmr::memory_resource*.
+ *Other containers (like std::array, or containers using std::allocator) are default constructed*/
+template<typename T, typename Resource>
+T make_with_resource([[maybe_unused]] Resource* resource)
+{
+	if constexpr (std::uses_allocator_v<T, Resource*>)
+	{
+		return T(typename T::allocator_type(resource));
+	}
+	else
+	{
+		return T();
+	}
+}
+
 struct multi_size
 {
 	multi_size()
@@ -75,6 +424,287 @@ private:
 	std::size_t val;
 };
 
+/*Helper struct for TupleForEach::foreach() to check if all containers have the expected size*/
+struct multi_size_check
+{
+	multi_size_check(std::size_t expected) : expected(expected), val(true)
+	{
+	}
+
+	template<typename T>
+	void operator()(T const& cont)
+	{
+		val = val && (cont.size() == expected);
+	}
+
+	bool value()
+	{
+		return val;
+	}
+
+private:
+	std::size_t expected;
+	bool val;
+};
+
+/*Size of a mvg::multi_container. When Cached is false, the size is computed from the containers every time it's needed,
+ *and the functions to update the size do nothing. When Cached is true, the size is stored and updated by every
+ *modifying operation of the multi_container*/
+template<bool Cached>
+struct size_cache
+{
+	template<typename Tpl>
+	std::size_t value(Tpl const& conts) const
+	{
+		multi_size sz;
+		TupleForEach::foreach(conts, sz);
+		return sz.value();
+	}
+
+	template<typename Tpl>
+	void reset([[maybe_unused]] Tpl const& conts)
+	{
+	}
+
+	void grow([[maybe_unused]] std::size_t n)
+	{
+	}
+
+	void shrink([[maybe_unused]] std::size_t n)
+	{
+	}
+};
+
+template<>
+struct size_cache<true>
+{
+	template<typename Tpl>
+	std::size_t value([[maybe_unused]] Tpl const& conts) const
+	{
+		dbg_assert((check(conts)), "multi_container containers don't have the same size");
+		return m_size;
+	}
+
+	template<typename Tpl>
+	void reset(Tpl const& conts)
+	{
+		multi_size sz;
+		TupleForEach::foreach(conts, sz);
+		m_size = sz.value();
+	}
+
+	void grow(std::size_t n)
+	{
+		m_size += n;
+	}
+
+	void shrink(std::size_t n)
+	{
+		m_size -= n;
+	}
+
+private:
+	template<typename Tpl>
+	bool check(Tpl const& conts) const
+	{
+		multi_size_check chk(m_size);
+		TupleForEach::foreach(conts, chk);
+		return chk.value();
+	}
+
+	std::size_t m_size = 0;
+};
+
+/*Traits to check if a container supports reserve(), capacity() and shrink_to_fit()*/
+template<typename T, typename = std::void_t<>>
+struct has_reserve : public std::false_type {};
+
+template<typename T>
+struct has_reserve<T, std::void_t<decltype(std::declval<T&>().reserve(std::size_t {}))>> : public std::true_type {};
+
+template<typename T, typename = std::void_t<>>
+struct has_capacity : public std::false_type {};
+
+template<typename T>
+struct has_capacity<T, std::void_t<decltype(std::declval<T const&>().capacity())>> : public std::true_type {};
+
+template<typename T, typename = std::void_t<>>
+struct has_shrink_to_fit : public std::false_type {};
+
+template<typename T>
+struct has_shrink_to_fit<T, std::void_t<decltype(std::declval<T&>().shrink_to_fit())>> : public std::true_type {};
+
+/*Helper struct for TupleForEach::foreach(). Calls reserve() on all containers that support it*/
+struct multi_reserve
+{
+	multi_reserve(std::size_t n) : n(n)
+	{
+	}
+
+	template<typename T>
+	void operator()(T& cont)
+	{
+		if constexpr (has_reserve<T>::value)
+		{
+			cont.reserve(n);
+		}
+	}
+
+private:
+	std::size_t n;
+};
+
+/*Helper struct for TupleForEach::foreach(). Computes the smallest capacity of all containers that have a capacity*/
+struct multi_capacity
+{
+	multi_capacity()
+	{
+		val = std::numeric_limits<std::size_t>::max();
+	}
+
+	template<typename T>
+	void operator()(T const& cont)
+	{
+		if constexpr (has_capacity<T>::value)
+		{
+			if (cont.capacity() < val)
+			{
+				val = cont.capacity();
+			}
+		}
+	}
+
+	//Returns std::numeric_limits<std::size_t>::max() if no container has a capacity
+	std::size_t value()
+	{
+		return val;
+	}
+
+private:
+	std::size_t val;
+};
+
+/*Records the capacity of every container that has a capacity(), and counts a reallocation for each of them
+ *whose capacity changed when it is destroyed. The disabled version is empty*/
+template<bool Enabled, typename... Cs>
+struct reallocation_watch
+{
+	explicit reallocation_watch([[maybe_unused]] std::tuple<Cs...> const& conts)
+	{
+	}
+};
+
+template<typename... Cs>
+struct reallocation_watch<true, Cs...>
+{
+	explicit reallocation_watch(std::tuple<Cs...> const& conts) : conts(conts)
+	{
+		capacities = std::apply([](Cs const&... c) { return std::array<std::size_t, sizeof...(Cs)> { capacity_of(c)... }; }, conts);
+	}
+
+	reallocation_watch(reallocation_watch const&) = delete;
+	reallocation_watch& operator=(reallocation_watch const&) = delete;
+
+	~reallocation_watch()
+	{
+		std::size_t column = 0;
+		std::apply([this, &column](Cs const&... c)
+		{
+			((capacity_of(c) != capacities[column] ? instr::reallocation(column) : void(), ++column), ...);
+		}, conts);
+	}
+
+private:
+	template<typename C>
+	static std::size_t capacity_of([[maybe_unused]] C const& cont)
+	{
+		if constexpr (has_capacity<C>::value)
+		{
+			return cont.capacity();
+		}
+		else
+		{
+			return 0;
+		}
+	}
+
+	std::tuple<Cs...> const& conts;
+	std::array<std::size_t, sizeof...(Cs)> capacities;
+};
+
+/*Helper struct for TupleForEach::foreach(). Calls shrink_to_fit() on all containers that support it*/
+struct multi_shrink_to_fit
+{
+	template<typename T>
+	void operator()(T& cont)
+	{
+		if constexpr (has_shrink_to_fit<T>::value)
+		{
+			cont.shrink_to_fit();
+		}
+	}
+};
+
+struct multi_resize
+{
+	multi_resize(std::size_t n) : n(n)
+	{
+	}
+
+	template<typename C>
+	void operator()(C& c)
+	{
+		c.resize(n);
+	}
+
+	template<typename C, typename T>
+	void operator()(C& c, T const& elem)
+	{
+		c.resize(n, elem);
+	}
+
+private:
+	std::size_t n;
+};
+
+/*Removes the elements whose keep flag is 0 from the first keep.size() elements of a container, keeping the order
+ *of the other elements, and erases the left over tail with a single erase call. first is the index of the first removed element.
+ *For trivially copyable elements every element is written and the output position is advanced by its flag, without branches*/
+struct multi_compact
+{
+	multi_compact(std::vector<std::uint8_t> const& keep, std::size_t first) : keep(keep), first(first)
+	{
+	}
+
+	template<typename C>
+	void operator()(C& c)
+	{
+		using T = typename std::iterator_traits<decltype(std::begin(c))>::value_type;
+
+		auto out = std::next(std::begin(c), first);
+		auto in = out;
+		++in;
+		for (std::size_t i = first + 1, n = keep.size(); i < n; ++i, ++in)
+		{
+			if constexpr (std::is_trivially_copyable_v<T>)
+			{
+				*out = *in;
+				std::advance(out, keep[i]);
+			}
+			else if (keep[i])
+			{
+				*out = std::move(*in);
+				++out;
+			}
+		}
+		c.erase(out, in);
+	}
+
+private:
+	std::vector<std::uint8_t> const& keep;
+	std::size_t first;
+};
+
 struct multi_clear
 {
 	template<typename T>
@@ -110,28 +740,132 @@ class multi_insert
 	static auto
 	do_insert_helper(It const& pos, std::tuple<Cs...>& conts, std::tuple<Ts...> const& elems)
 	{
-		return std::get<I>(conts).insert(std::get<I>(pos.m_iterators), std::get<I>(elems));
+		return std::get<I>(conts).insert(container_position<I>(std::get<I>(conts), pos), std::get<I>(elems));
 	}
 
-	template<typename It, typename... Cs, typename...Ts, std::size_t... Is>
-	static It do_insert(It const& pos, std::tuple<Cs...>& conts, std::tuple<Ts...> const& elems, std::index_sequence<Is...>)
+	template<typename Res, typename It, typename... Cs, typename...Ts, std::size_t... Is>
+	static Res do_insert(It const& pos, std::tuple<Cs...>& conts, std::tuple<Ts...> const& elems, std::index_sequence<Is...>)
 	{
-		return mvg::multi_iterator(do_insert_helper<Is>(pos, conts, elems) ...);
+		return rebuild_iterator<Res>(conts, do_insert_helper<Is>(pos, conts, elems) ...);
 //		(std::get<Is>(conts).insert((*pos).get_elem<Is>()..., std::get<Is>(elems)) ...);
 	}
+
+	template<std::size_t I, typename It, typename... Cs, typename... Firsts, typename... Lasts>
+	static auto do_insert_range_helper(It const& pos, std::tuple<Cs...>& conts,
+		std::tuple<Firsts...> const& first, std::tuple<Lasts...> const& last)
+	{
+		auto& cont = std::get<I>(conts);
+		return cont.insert(container_position<I>(cont, pos), std::get<I>(first), std::get<I>(last));
+	}
+
+	template<typename Res, typename It, typename... Cs, typename... Firsts, typename... Lasts, std::size_t... Is>
+	static Res do_insert_range(It const& pos, std::tuple<Cs...>& conts,
+		std::tuple<Firsts...> const& first, std::tuple<Lasts...> const& last, std::index_sequence<Is...>)
+	{
+		return rebuild_iterator<Res>(conts, do_insert_range_helper<Is>(pos, conts, first, last) ...);
+	}
+
+	template<std::size_t I, typename It, typename... Cs, typename... Ts>
+	static auto do_insert_count_helper(It const& pos, std::tuple<Cs...>& conts, std::size_t count, std::tuple<Ts...> const& elems)
+	{
+		auto& cont = std::get<I>(conts);
+		return cont.insert(container_position<I>(cont, pos), count, std::get<I>(elems));
+	}
+
+	template<typename Res, typename It, typename... Cs, typename... Ts, std::size_t... Is>
+	static Res do_insert_count(It const& pos, std::tuple<Cs...>& conts, std::size_t count, std::tuple<Ts...> const& elems,
+		std::index_sequence<Is...>)
+	{
+		return rebuild_iterator<Res>(conts, do_insert_count_helper<Is>(pos, conts, count, elems) ...);
+	}
+
 public:
-	template<typename It, typename...Cs, typename...Ts>
-	static It insert(It const& pos, std::tuple<Cs...>& conts, std::tuple<Ts...> const& elems)
+	//Res is the type of the returned iterator, pos may also be a const iterator
+	template<typename Res, typename It, typename...Cs, typename...Ts>
+	static Res insert(It const& pos, std::tuple<Cs...>& conts, std::tuple<Ts...> const& elems)
 	{
-		return do_insert(
+		return do_insert<Res>(
 			pos, 
 			conts,
 			elems,
 			std::index_sequence_for<Ts...> {});
 		
 	}
+
+	//Inserts [std::get<I>(first), std::get<I>(last)[ into the container at index I, with a single call to its range insert.
+	//Res is the type of the returned iterator
+	template<typename Res, typename It, typename... Cs, typename... Firsts, typename... Lasts>
+	static Res insert(It const& pos, std::tuple<Cs...>& conts, std::tuple<Firsts...> const& first, std::tuple<Lasts...> const& last)
+	{
+		return do_insert_range<Res>(pos, conts, first, last, std::index_sequence_for<Cs...> {});
+	}
+
+	//Inserts count copies of std::get<I>(elems) into the container at index I, with a single call to its insert
+	template<typename Res, typename It, typename... Cs, typename... Ts>
+	static Res insert(It const& pos, std::tuple<Cs...>& conts, std::size_t count, std::tuple<Ts...> const& elems)
+	{
+		return do_insert_count<Res>(pos, conts, count, elems, std::index_sequence_for<Cs...> {});
+	}
 };
 
+class multi_emplace
+{
+	template<typename C, typename Args>
+	static void do_emplace_back_helper(C& cont, Args&& args)
+	{
+		std::apply([&cont](auto&&... a) { cont.emplace_back(std::forward<decltype(a)>(a) ...); }, std::forward<Args>(args));
+	}
+
+	template<typename... Cs, typename... Args, std::size_t... Is>
+	static void do_emplace_back(std::tuple<Cs...>& conts, std::index_sequence<Is...>, Args&&... args)
+	{
+		(do_emplace_back_helper(std::get<Is>(conts), std::forward<Args>(args)), ...);
+	}
+
+	template<std::size_t I, typename It, typename... Cs, typename Args>
+	static auto do_emplace_helper(It const& pos, std::tuple<Cs...>& conts, Args&& args)
+	{
+		auto& cont = std::get<I>(conts);
+		auto where = container_position<I>(cont, pos);
+		return std::apply([&cont, &where](auto&&... a) { return cont.emplace(where, std::forward<decltype(a)>(a) ...); },
+			std::forward<Args>(args));
+	}
+
+	template<typename Res, typename It, typename... Cs, typename... Args, std::size_t... Is>
+	static Res do_emplace(It const& pos, std::tuple<Cs...>& conts, std::index_sequence<Is...>, Args&&... args)
+	{
+		return rebuild_iterator<Res>(conts, do_emplace_helper<Is>(pos, conts, std::forward<Args>(args)) ...);
+	}
+
+	template<typename... Cs, typename... Ts, std::size_t... Is>
+	static void do_push_back(std::tuple<Cs...>& conts, std::tuple<Ts...>&& elems, std::index_sequence<Is...>)
+	{
+		(std::get<Is>(conts).push_back(std::get<Is>(std::move(elems))), ...);
+	}
+
+public:
+	//Constructs an element at the end of the container at index I, with the arguments stored in the tuple at index I of args
+	template<typename... Cs, typename... Args>
+	static void emplace_back(std::tuple<Cs...>& conts, Args&&... args)
+	{
+		do_emplace_back(conts, std::index_sequence_for<Cs...> {}, std::forward<Args>(args)...);
+	}
+
+	//Constructs an element before pos in the container at index I, with the arguments stored in the tuple at index I of args.
+	//Res is the type of the returned iterator
+	template<typename Res, typename It, typename... Cs, typename... Args>
+	static Res emplace(It const& pos, std::tuple<Cs...>& conts, Args&&... args)
+	{
+		return do_emplace<Res>(pos, conts, std::index_sequence_for<Cs...> {}, std::forward<Args>(args)...);
+	}
+
+	//Moves the element at index I of elems to the end of the container at index I
+	template<typename... Cs, typename... Ts>
+	static void push_back(std::tuple<Cs...>& conts, std::tuple<Ts...>&& elems)
+	{
+		do_push_back(conts, std::move(elems), std::index_sequence_for<Cs...> {});
+	}
+};
 
 class multi_erase
 {
@@ -139,32 +873,69 @@ private:
 	template<std::size_t I, typename It, typename... Cs>
 	static auto do_erase_helper(std::tuple<Cs...>& conts, It pos)
 	{
-		return std::get<I>(conts).erase(std::get<I>(pos.m_iterators));
+		return std::get<I>(conts).erase(container_position<I>(std::get<I>(conts), pos));
 	}
 
-	template<typename It, typename... Cs, std::size_t... Is>
-	static It do_erase(std::tuple<Cs...>& conts, It pos, std::index_sequence<Is...>)
+	template<typename Res, typename It, typename... Cs, std::size_t... Is>
+	static Res do_erase(std::tuple<Cs...>& conts, It pos, std::index_sequence<Is...>)
 	{
-		return mvg::multi_iterator(do_erase_helper<Is>(conts, pos) ...);
+		return rebuild_iterator<Res>(conts, do_erase_helper<Is>(conts, pos) ...);
+	}
+
+	template<std::size_t I, typename It, typename... Cs>
+	static auto do_erase_range_helper(std::tuple<Cs...>& conts, It first, It last)
+	{
+		auto& cont = std::get<I>(conts);
+		return cont.erase(container_position<I>(cont, first), container_position<I>(cont, last));
+	}
+
+	template<typename Res, typename It, typename... Cs, std::size_t... Is>
+	static Res do_erase_range(std::tuple<Cs...>& conts, It first, It last, std::index_sequence<Is...>)
+	{
+		return rebuild_iterator<Res>(conts, do_erase_range_helper<Is>(conts, first, last) ...);
 	}
 
 public:
-	template<typename It, typename... Cs>
-	static It erase(std::tuple<Cs...>& conts, It pos)
+	//Res is the type of the returned iterator, pos may also be a const iterator
+	template<typename Res, typename It, typename... Cs>
+	static Res erase(std::tuple<Cs...>& conts, It pos)
 	{
-		return do_erase(conts, pos, std::index_sequence_for<Cs...> {});
+		return do_erase<Res>(conts, pos, std::index_sequence_for<Cs...> {});
+	}
+
+	//Erases [first, last[ from every container with a single call to its range erase. Res is the type of the returned iterator
+	template<typename Res, typename It, typename... Cs>
+	static Res erase(std::tuple<Cs...>& conts, It first, It last)
+	{
+		return do_erase_range<Res>(conts, first, last, std::index_sequence_for<Cs...> {});
 	}
 };
 
+/*Defined in the opt-in headers parallel.hpp, column_kernels.hpp and column_file.hpp. multi_container only declares them,
+ *so its parallel algorithms, column kernels and save() need the header that defines them, and nothing else pulls in
+ *<thread>, the SIMD intrinsics or <filesystem>*/
+template<typename Container>
+struct parallel_rows;
+
+template<typename Container>
+struct column_kernels;
+
+template<typename Container>
+struct column_writer;
+
 } //namespace detail
 
+//Defined in column_view.hpp, which is needed to use multi_container::columns()
+template<typename It>
+class column_view;
+
 //Warning: using structured binding gives reference, even when doing for(auto[a, b, c] : m) !!
 template<typename... Ts>
 class multi_container
 {
 public:
-	using iterator = multi_iterator<typename detail::underlying_iterator<Ts>::type ...>;
-	using const_iterator = multi_iterator<typename detail::underlying_const_iterator<Ts>::type ...>;
+	using iterator = typename detail::container_iterator_t<Ts...>::type;
+	using const_iterator = typename detail::container_iterator_t<Ts...>::const_type;
 	using value_type = detail::tuple_wrapper<Ts...>;
 	using reference = detail::tuple_wrapper<std::add_lvalue_reference_t<Ts> ...>;
 	using pointer = std::add_pointer_t<value_type>;
@@ -173,69 +944,93 @@ public:
 	using size_type = std::size_t;
 	using difference_type = std::ptrdiff_t;
 
+	static_assert(!(std::is_trivially_copyable_v<typename detail::underlying_iterator<Ts>::type> && ...) ||
+		std::is_trivially_copyable_v<iterator>, "multi_container iterators must be trivially copyable when the container iterators are");
+
 	multi_container()
 	{
-		
+		m_size.reset(m_containers);
 	}
 
 
 	multi_container(Ts const&... containers) : m_containers(containers...)
 	{
-
+		m_size.reset(m_containers);
 	}
 
 	multi_container(std::add_rvalue_reference_t<Ts>... containers) :
 		m_containers(std::forward<std::add_rvalue_reference_t<Ts>>(containers)...)
 	{
+		m_size.reset(m_containers);
 	}
 
 	multi_container(std::tuple<Ts const&>... containers) :
-		m_containers(containers)
+		m_containers(std::get<0>(containers)...)
 	{
+		m_size.reset(m_containers);
 	}
 	
+	//All containers whose allocator can be constructed from resource, like containers using a std::pmr::polymorphic_allocator
+	//and a std::pmr::memory_resource*, allocate from it, other containers are default constructed.
+	//The types of the containers can't be deduced from this constructor
+	template<typename Resource, typename = std::enable_if_t<(std::uses_allocator_v<Ts, Resource*> || ...)>>
+	explicit multi_container(Resource* resource) :
+		m_containers(detail::make_with_resource<Ts>(resource)...)
+	{
+		m_size.reset(m_containers);
+	}
+
 	multi_container(multi_container const&) = default;
-	multi_container(multi_container&&) = default;
+
+	multi_container(multi_container&& rhs) : 
+		m_containers(std::move(rhs.m_containers)), m_size(rhs.m_size)
+	{
+		rhs.m_size.reset(rhs.m_containers);
+	}
 
 	multi_container& operator=(multi_container const& rhs)
 	{
 		m_containers = rhs.m_containers;
+		m_size = rhs.m_size;
 		return *this;
 	}
 
 	multi_container& operator=(multi_container&& rhs)
 	{
 		m_containers = std::move(rhs.m_containers);
+		m_size = rhs.m_size;
+		rhs.m_size.reset(rhs.m_containers);
+		return *this;
 	}
 
 	iterator begin()
 	{
-		return iterator(std::begin(std::get<Ts>(m_containers)) ...);
+		return detail::make_begin<iterator>(m_containers);
 	}
 
 	iterator end()
 	{
-		return iterator(std::end(std::get<Ts>(m_containers)) ...);
+		return detail::make_end<iterator>(m_containers, size());
 	}
 
 	const_iterator begin() const
 	{
-		return const_iterator(std::begin(std::get<Ts>(m_containers)) ...);
+		return detail::make_begin<const_iterator>(m_containers);
 	}
 
 	const_iterator end() const
 	{
-		return const_iterator(std::end(std::get<Ts>(m_containers)) ... );
+		return detail::make_end<const_iterator>(m_containers, size());
 	}
 
 	const_iterator cbegin() const
 	{
-		return const_iterator(std::begin(std::get<Ts>(m_containers)) ... );
+		return detail::make_begin<const_iterator>(m_containers);
 	}
 	
 	const_iterator cend() const
 	{
-		return const_iterator(std::end(std::get<Ts>(m_containers)) ... );
+		return detail::make_end<const_iterator>(m_containers, size());
 	}
 
 	reverse_iterator rbegin()
@@ -270,9 +1065,8 @@ public:
 
 	std::size_t size() const
 	{
-		detail::multi_size sz;
-		TupleForEach::foreach(m_containers, sz);
-		return sz.value();
+		detail::instr::count(detail::stat_counter::size);
+		return m_size.value(m_containers);
 	}
 
 	auto operator[](std::size_t index)
@@ -289,7 +1083,7 @@ public:
 
 	auto at(std::size_t index)
 	{
-		if (index > size())
+		if (index >= size())
 		{
 			throw std::out_of_range("multi_container iterator out of range");
 		}
@@ -298,7 +1092,7 @@ public:
 
 	auto at(std::size_t index) const
 	{
-		if (index > size())
+		if (index >= size())
 		{
 			throw std::out_of_range("multi_container iterator out of range");
 		}
@@ -330,16 +1124,79 @@ public:
 		return size() == 0;
 	}
 
+	//Calls reserve() on all containers that support it
+	void reserve(size_type n)
+	{
+		[[maybe_unused]] auto watch = watch_reallocations();
+		TupleForEach::foreach(m_containers, detail::multi_reserve { n });
+	}
+
+	//Returns the smallest capacity of all containers that have a capacity(), or size() if none of them do
+	size_type capacity() const
+	{
+		detail::multi_capacity cap;
+		TupleForEach::foreach(m_containers, cap);
+		if (cap.value() == std::numeric_limits<size_type>::max())
+		{
+			return size();
+		}
+		return cap.value();
+	}
+
+	//Calls shrink_to_fit() on all containers that support it
+	void shrink_to_fit()
+	{
+		TupleForEach::foreach(m_containers, detail::multi_shrink_to_fit {});
+	}
+
 	void clear()
 	{
 		TupleForEach::foreach(m_containers, detail::multi_clear {});
+		m_size.reset(m_containers);
 	}
 
 	template<typename... Elems>
 	void push_back(std::tuple<Elems...> const& elems)
 	{
 		static_assert(sizeof...(Elems) == sizeof...(Ts), "Invalid argument count");
+		[[maybe_unused]] auto timing = detail::instr::time(detail::stat_counter::push_back);
+		[[maybe_unused]] auto watch = watch_reallocations();
 		TupleForEach::parallel_foreach(m_containers, elems, detail::multi_push_back {});
+		m_size.grow(1);
+	}
+
+	template<typename... Elems>
+	void push_back(std::tuple<Elems...>&& elems)
+	{
+		static_assert(sizeof...(Elems) == sizeof...(Ts), "Invalid argument count");
+		[[maybe_unused]] auto timing = detail::instr::time(detail::stat_counter::push_back);
+		[[maybe_unused]] auto watch = watch_reallocations();
+		detail::multi_emplace::push_back(m_containers, std::move(elems));
+		m_size.grow(1);
+	}
+
+	//Every argument is a tuple holding the constructor arguments for the element of one container, 
+	//eg. emplace_back(std::forward_as_tuple(1), std::forward_as_tuple("abc", 2))
+	template<typename... ArgTuples>
+	void emplace_back(ArgTuples&&... args)
+	{
+		static_assert(sizeof...(ArgTuples) == sizeof...(Ts), "Invalid argument count");
+		[[maybe_unused]] auto timing = detail::instr::time(detail::stat_counter::emplace);
+		[[maybe_unused]] auto watch = watch_reallocations();
+		detail::multi_emplace::emplace_back(m_containers, std::forward<ArgTuples>(args)...);
+		m_size.grow(1);
+	}
+
+	//Same as emplace_back(), but constructs the elements before pos
+	template<typename... ArgTuples>
+	iterator emplace(iterator pos, ArgTuples&&... args)
+	{
+		static_assert(sizeof...(ArgTuples) == sizeof...(Ts), "Invalid argument count");
+		[[maybe_unused]] auto timing = detail::instr::time(detail::stat_counter::emplace);
+		[[maybe_unused]] auto watch = watch_reallocations();
+		iterator it = detail::multi_emplace::emplace<iterator>(pos, m_containers, std::forward<ArgTuples>(args)...);
+		m_size.grow(1);
+		return it;
 	}
 
 	//Insert element after pos
@@ -347,72 +1204,328 @@ public:
 	iterator insert(iterator pos, std::tuple<Elems...> const& elems)
 	{
 		static_assert(sizeof...(Elems) == sizeof...(Ts), "Invalid argument count");
-		return detail::multi_insert::insert(pos, m_containers, elems);
+		[[maybe_unused]] auto timing = detail::instr::time(detail::stat_counter::insert);
+		[[maybe_unused]] auto watch = watch_reallocations();
+		iterator it = detail::multi_insert::insert<iterator>(pos, m_containers, elems);
+		m_size.grow(1);
+		return it;
 	}
 
 	template<typename... Elems>
 	iterator insert(const_iterator pos, std::tuple<Elems...> const& elems)
 	{
 		static_assert(sizeof...(Elems) == sizeof...(Ts), "Invalid argument count");
-		return detail::multi_insert::insert(pos, m_containers, elems);
+		[[maybe_unused]] auto timing = detail::instr::time(detail::stat_counter::insert);
+		[[maybe_unused]] auto watch = watch_reallocations();
+		iterator it = detail::multi_insert::insert<iterator>(pos, m_containers, elems);
+		m_size.grow(1);
+		return it;
 	}
 
-	//Does not check if [first, last[ is a valid range
-	template<typename InputIt>
+	//Does not check if [first, last[ is a valid range. InputIt can be any multi_iterator with one column per container
+	template<typename InputIt, typename = std::enable_if_t<detail::is_multi_iterator_v<InputIt>>>
 	iterator insert(iterator pos, InputIt first, InputIt last)
 	{
-		while(first != last)
-		{
-			pos = detail::multi_insert::insert(pos, m_containers, (*first).m_tuple);
-			++pos;
-			++first;
-		}
-		return pos;
+		return insert(pos, detail::column_iterators(first), detail::column_iterators(last));
 	}
 
-	void insert(iterator pos, size_type count, std::tuple<Ts...> const& elem)
+	//Inserts [std::get<I>(first), std::get<I>(last)[ into the container at index I. Does not check if the ranges are valid,
+	//or if they all have the same length
+	template<typename... Firsts, typename... Lasts>
+	iterator insert(iterator pos, std::tuple<Firsts...> const& first, std::tuple<Lasts...> const& last)
 	{
-		for (int i = 0; i < count; ++i)
-		{
-			pos = insert(pos, elem);
-		}
+		static_assert(sizeof...(Firsts) == sizeof...(Ts) && sizeof...(Lasts) == sizeof...(Ts), "Invalid argument count");
+		std::size_t count = std::distance(std::get<0>(first), std::get<0>(last));
+		[[maybe_unused]] auto timing = detail::instr::time(detail::stat_counter::insert);
+		[[maybe_unused]] auto watch = watch_reallocations();
+		iterator it = detail::multi_insert::insert<iterator>(pos, m_containers, first, last);
+		m_size.grow(count);
+		return it;
+	}
+
+	template<typename... Elems>
+	iterator insert(iterator pos, size_type count, std::tuple<Elems...> const& elems)
+	{
+		static_assert(sizeof...(Elems) == sizeof...(Ts), "Invalid argument count");
+		[[maybe_unused]] auto timing = detail::instr::time(detail::stat_counter::insert);
+		[[maybe_unused]] auto watch = watch_reallocations();
+		iterator it = detail::multi_insert::insert<iterator>(pos, m_containers, count, elems);
+		m_size.grow(count);
+		return it;
 	}
 
 	iterator erase(iterator pos)
 	{
-		return detail::multi_erase::erase(m_containers, pos);
+		[[maybe_unused]] auto timing = detail::instr::time(detail::stat_counter::erase);
+		iterator it = detail::multi_erase::erase<iterator>(m_containers, pos);
+		m_size.shrink(1);
+		return it;
 	}
 
 	iterator erase(const_iterator pos)
 	{
-		return detail::multi_erase::erase(m_containers, pos);
+		[[maybe_unused]] auto timing = detail::instr::time(detail::stat_counter::erase);
+		iterator it = detail::multi_erase::erase<iterator>(m_containers, pos);
+		m_size.shrink(1);
+		return it;
 	}
 
 	iterator erase(iterator first, iterator last)
 	{
+		[[maybe_unused]] auto timing = detail::instr::time(detail::stat_counter::erase);
 		std::size_t count = std::distance(first, last);
-		iterator pos = first;
-		for(std::size_t i = 0; i < count; ++i)
-		{
-			pos = detail::multi_erase::erase(m_containers, pos);		
-		}
+		iterator pos = detail::multi_erase::erase<iterator>(m_containers, first, last);
+		m_size.shrink(count);
 		return pos;
 	}
 
 	iterator erase(const_iterator first, const_iterator last)
 	{
+		[[maybe_unused]] auto timing = detail::instr::time(detail::stat_counter::erase);
 		std::size_t count = std::distance(first, last);
-		iterator pos = first;
-		for (std::size_t i = 0; i < count; ++i)
+		iterator pos = detail::multi_erase::erase<iterator>(m_containers, first, last);
+		m_size.shrink(count);
+		return pos;
+	}
+
+	//Removes all rows for which pred(row) returns true, keeping the order of the other rows. pred is called once per row,
+	//then every container is compacted on its own and truncated with a single erase. Returns the number of removed rows
+	template<typename Pred>
+	size_type remove_if_rows(Pred pred)
+	{
+		[[maybe_unused]] auto timing = detail::instr::time(detail::stat_counter::remove_if);
+		std::size_t const n = size();
+
+		std::vector<std::uint8_t> keep(n);
+		std::size_t kept = 0;
+		auto it = begin();
+		for (std::size_t i = 0; i < n; ++i, ++it)
 		{
-			pos = detail::multi_erase::erase(m_containers, pos);
+			keep[i] = !static_cast<bool>(pred(*it));
+			kept += keep[i];
 		}
-		return pos;
+		if (kept == n)
+		{
+			return 0;
+		}
+
+		std::size_t const first = std::find(keep.begin(), keep.end(), std::uint8_t(0)) - keep.begin();
+		TupleForEach::foreach(m_containers, detail::multi_compact { keep, first });
+		m_size.shrink(n - kept);
+		return n - kept;
+	}
+
+	void resize(size_type n)
+	{
+		[[maybe_unused]] auto watch = watch_reallocations();
+		TupleForEach::foreach(m_containers, detail::multi_resize { n });
+		m_size.reset(m_containers);
+	}
+
+	template<typename... Elems>
+	void resize(size_type n, std::tuple<Elems...> const& elems)
+	{
+		static_assert(sizeof...(Elems) == sizeof...(Ts), "Invalid argument count");
+		[[maybe_unused]] auto watch = watch_reallocations();
+		TupleForEach::parallel_foreach(m_containers, elems, detail::multi_resize { n });
+		m_size.reset(m_containers);
 	}
 
 	void pop_back()
 	{
 		TupleForEach::foreach(m_containers, detail::multi_pop_back {});
+		m_size.shrink(1);
+	}
+
+	//Sorts the container at index I with comp, and reorders all other containers in the same order.
+	//The row indices are sorted by their keys, without moving the keys, so nothing is changed if comp throws. The resulting
+	//permutation is then applied to every container in a single pass, instead of swapping whole rows while sorting
+	template<std::size_t I, typename Compare = std::less<>>
+	void sort_by(Compare comp = Compare {})
+	{
+		std::vector<std::size_t> perm = detail::sort_positions(std::get<I>(m_containers), size(), comp);
+		detail::permute_containers<sizeof...(Ts)>(m_containers, perm, std::index_sequence_for<Ts...> {});
+	}
+
+	//Sorts all rows by the key returned by proj(row), which is evaluated once per row
+	template<typename Proj, typename Compare = std::less<>>
+	void sort_by(Proj proj, Compare comp = Compare {})
+	{
+		using K = std::decay_t<decltype(proj(*std::declval<iterator>()))>;
+
+		std::size_t const n = size();
+
+		std::vector<std::pair<K, std::size_t>> keys;
+		keys.reserve(n);
+		auto it = begin();
+		for (std::size_t i = 0; i < n; ++i, ++it)
+		{
+			keys.emplace_back(proj(*it), i);
+		}
+
+		std::vector<std::size_t> perm = detail::sort_keys(keys, comp);
+		detail::permute_containers<sizeof...(Ts)>(m_containers, perm, std::index_sequence_for<Ts...> {});
+	}
+
+	//Stable radix sort on the container at index I, which must hold integral, float or double values.
+	//All other containers are reordered in the same order. Because it's stable, sorting by multiple keys
+	//can be done by sorting by the least significant key first
+	template<std::size_t I>
+	void radix_sort_by()
+	{
+		auto& key_cont = std::get<I>(m_containers);
+		std::size_t const n = size();
+
+		using U = decltype(detail::radix_key(*std::begin(key_cont)));
+		std::vector<U> keys;
+		keys.reserve(n);
+		auto key_it = std::begin(key_cont);
+		for (std::size_t i = 0; i < n; ++i, ++key_it)
+		{
+			keys.push_back(detail::radix_key(*key_it));
+		}
+
+		std::vector<std::size_t> perm = detail::radix_sort_permutation(keys);
+		detail::permute_containers<sizeof...(Ts)>(m_containers, perm, std::index_sequence_for<Ts...> {});
+	}
+
+	//Calls f(row) for every row. The rows are split in chunks that are processed on multiple threads, which all call
+	//the same f without copying it, so f must be safe to call concurrently. Requires random access containers.
+	//The parallel algorithms are implemented in parallel.hpp, which has to be included to use them
+	template<typename F>
+	void for_each_row(F&& f)
+	{
+		static_assert(detail::is_at_least_tag_v<typename iterator::iterator_category, std::random_access_iterator_tag>,
+			"for_each_row requires random access containers");
+		detail::parallel_rows<multi_container>::for_each_row(*this, std::forward<F>(f));
+	}
+
+	//Writes f(row) to d_first[i] for every row i, on multiple threads sharing f like for_each_row(). Returns d_first + size()
+	template<typename RandomIt, typename F>
+	RandomIt transform_rows(RandomIt d_first, F&& f)
+	{
+		static_assert(detail::is_at_least_tag_v<typename iterator::iterator_category, std::random_access_iterator_tag>,
+			"transform_rows requires random access containers");
+		return detail::parallel_rows<multi_container>::transform_rows(*this, d_first, std::forward<F>(f));
+	}
+
+	//Reduces transform(row) of all rows with reduce, on multiple threads. Every thread reduces its own chunk,
+	//the results of all chunks are then reduced in order, starting with init. reduce must be associative.
+	//All threads share reduce and transform like for_each_row()
+	template<typename T, typename Reduce, typename Transform>
+	T reduce_rows(T init, Reduce&& reduce, Transform&& transform)
+	{
+		static_assert(detail::is_at_least_tag_v<typename iterator::iterator_category, std::random_access_iterator_tag>,
+			"reduce_rows requires random access containers");
+		return detail::parallel_rows<multi_container>::reduce_rows(*this, std::move(init), std::forward<Reduce>(reduce),
+			std::forward<Transform>(transform));
+	}
+
+	//Calls f(spans...) for every batch of W rows, with a batch_span over the rows of the batch in every container.
+	//The spans are batch_span<T, W> for full batches and batch_span<T> for the last one.
+	//Requires all containers to be contiguous. This and the column kernels below are implemented in column_kernels.hpp,
+	//which has to be included to use them
+	template<std::size_t W, typename F>
+	void for_each_batch(F f)
+	{
+		static_assert(detail::is_indexed_iterator_v<iterator>, "for_each_batch requires contiguous containers");
+
+		std::size_t const n = size();
+		std::apply([n, &f](auto&... conts)
+		{
+			detail::column_kernels<multi_container>::template for_each_batch<W>(n, f, std::data(conts)...);
+		}, m_containers);
+	}
+
+	//Sum of the container at index I, integers are summed in 64 bit integers
+	template<std::size_t I>
+	auto sum() const
+	{
+		static_assert(detail::is_contiguous_container_v<std::tuple_element_t<I, std::tuple<Ts...>>>,
+			"sum requires a contiguous container");
+		return detail::column_kernels<multi_container>::sum(std::data(std::get<I>(m_containers)), size());
+	}
+
+	//Smallest and largest value of the container at index I. The container can't be empty
+	template<std::size_t I>
+	auto min_max() const
+	{
+		static_assert(detail::is_contiguous_container_v<std::tuple_element_t<I, std::tuple<Ts...>>>,
+			"min_max requires a contiguous container");
+		dbg_assert((!empty()), "min_max called on an empty multi_container");
+		return detail::column_kernels<multi_container>::min_max(std::data(std::get<I>(m_containers)), size());
+	}
+
+	//Dot product of the containers at index I and J
+	template<std::size_t I, std::size_t J>
+	auto dot() const
+	{
+		static_assert(detail::is_contiguous_container_v<std::tuple_element_t<I, std::tuple<Ts...>>> &&
+			detail::is_contiguous_container_v<std::tuple_element_t<J, std::tuple<Ts...>>>,
+			"dot requires contiguous containers");
+		return detail::column_kernels<multi_container>::dot(std::data(std::get<I>(m_containers)), std::data(std::get<J>(m_containers)),
+			size());
+	}
+
+	//Copies the values of the container at index I for which the value in the container at index M is true to out.
+	//Returns the end of the output range
+	template<std::size_t I, std::size_t M, typename OutputIt>
+	OutputIt masked_select(OutputIt out) const
+	{
+		static_assert(detail::is_contiguous_container_v<std::tuple_element_t<I, std::tuple<Ts...>>> &&
+			detail::is_contiguous_container_v<std::tuple_element_t<M, std::tuple<Ts...>>>,
+			"masked_select requires contiguous containers");
+		return detail::column_kernels<multi_container>::masked_select(std::data(std::get<I>(m_containers)),
+			std::data(std::get<M>(m_containers)), size(), out);
+	}
+
+	//Returns a column_view over the containers at the indices Is, e.g. m.columns<0, 3>().
+	//Its iterators only hold the selected containers, so the other containers are never touched. Requires column_view.hpp
+	template<std::size_t... Is>
+	auto columns()
+	{
+		using It = typename detail::container_iterator_t<std::tuple_element_t<Is, std::tuple<Ts...>>...>::type;
+		auto conts = std::tie(std::get<Is>(m_containers)...);
+		std::size_t const n = size();
+		return column_view<It>(detail::make_begin<It>(conts), detail::make_end<It>(conts, n), n);
+	}
+
+	template<std::size_t... Is>
+	auto columns() const
+	{
+		using It = typename detail::container_iterator_t<std::tuple_element_t<Is, std::tuple<Ts...>>...>::const_type;
+		auto conts = std::tie(std::get<Is>(m_containers)...);
+		std::size_t const n = size();
+		return column_view<It>(detail::make_begin<It>(conts), detail::make_end<It>(conts, n), n);
+	}
+
+	//Returns a column_view over the containers selected by type, e.g. m.columns<int, float>().
+	//Every type is either the type of exactly one container, or the value type of exactly one container
+	template<typename... Us>
+	auto columns()
+	{
+		return columns<column_index<Us>()...>();
+	}
+
+	template<typename... Us>
+	auto columns() const
+	{
+		return columns<column_index<Us>()...>();
+	}
+
+	//Writes all containers to path in a columnar binary format, which can be mapped with mvg::load_mmap<Elems...>(path).
+	//path is anything std::filesystem::path can be constructed from. Requires contiguous containers of trivially
+	//copyable elements and column_file.hpp. Throws std::runtime_error when writing fails
+	template<typename Path>
+	void save(Path const& path) const
+	{
+		static_assert(detail::is_indexed_iterator_v<iterator>, "save requires contiguous containers");
+
+		std::size_t const n = size();
+		std::apply([&path, n](auto const&... conts)
+		{
+			detail::column_writer<multi_container>::save(path, n, std::data(conts)...);
+		}, m_containers);
 	}
 
 	template<typename T>
@@ -442,7 +1555,29 @@ public:
 	}
 
 private:
+	template<typename U>
+	static constexpr std::size_t column_index()
+	{
+		if constexpr (detail::has_unique_type_v<U, Ts...>)
+		{
+			return detail::type_index<U, Ts...>();
+		}
+		else
+		{
+			static_assert(detail::has_unique_type_v<U, detail::container_value_t<Ts>...>,
+				"Type must match exactly one container or the value type of exactly one container");
+			return detail::type_index<U, detail::container_value_t<Ts>...>();
+		}
+	}
+
+	//Counts the reallocations of a modifier when instrumentation is enabled, see instrumentation.hpp
+	detail::reallocation_watch<MVG_INSTRUMENTATION, Ts...> watch_reallocations() const
+	{
+		return detail::reallocation_watch<MVG_INSTRUMENTATION, Ts...>(m_containers);
+	}
+
 	std::tuple<Ts...> m_containers;
+	detail::size_cache<MVG_CACHE_SIZE> m_size;
 };
 
 template<typename...Ts>
@@ -14,7 +14,7 @@
 #include "TypeList.hpp"
 #include "Traits.hpp"
 #include "TupleForEach.hpp"
-#include "Unused.hpp"
+#include "instrumentation.hpp"
 
 #ifdef _DEBUG
 #define dbg_assert(cond, msg) if(!!cond) {} else {throw std::runtime_error(msg);}
@@ -28,6 +28,9 @@ namespace mvg
 template<typename...Ts>
 class multi_container;
 
+template<typename... Its>
+class multi_iterator;
+
 
 
 namespace detail
@@ -50,41 +53,115 @@ bool operator op(tuple_wrapper<Ts...> const& lhs, tuple_wrapper<Us...> const& rh
 template<typename... Ts, typename... Us> \
 bool operator op(tuple_wrapper<Ts...> const& lhs, std::tuple<Us...> const& rhs) {return lhs.m_tuple op rhs;} \
 template<typename... Ts, typename... Us> \
-bool operator op(std::tuple<Ts...>, tuple_wrapper<Us...> const& rhs) {return lhs op rhs.m_tuple;}
+bool operator op(std::tuple<Ts...> const& lhs, tuple_wrapper<Us...> const& rhs) {return lhs op rhs.m_tuple;}
 
-//Wrapper class around std::tuple for reference types. Used by mvg::multi_iterator to dereference
+//Wrapper class around std::tuple for reference types. Used by mvg::multi_iterator to dereference.
+//Like the reference of std::ranges::zip_view, a tuple_wrapper of references is a proxy for a row: copying it copies the
+//references, assigning to it assigns to the referenced elements, and swapping two of them swaps the elements one by one.
+//A tuple_wrapper of rvalue references (returned by iter_move()) moves the elements when it is assigned or converted to values
 template <typename... Ts>
 struct tuple_wrapper 
 {
 	std::tuple<Ts...> m_tuple;
 
-	using val_tuple_wrapper_t = tuple_wrapper<std::remove_reference_t<Ts>...>;
-	using tuple_wrapper_wrapper_t = tuple_wrapper<std::add_lvalue_reference_t<Ts>...>;
-	using val_tuple_t = std::tuple<std::remove_reference_t<Ts>...>;
-	using tuple_wrapper_t = std::tuple<std::add_lvalue_reference_t<Ts>...>;
-
-	tuple_wrapper(val_tuple_t &&t)
-		: m_tuple { std::move(t) } {}
-	tuple_wrapper(tuple_wrapper_t &&t)
+	tuple_wrapper(std::tuple<Ts...> t)
 		: m_tuple { std::move(t) } {}
-	tuple_wrapper(val_tuple_wrapper_t &&rhs) noexcept
-		: m_tuple { std::move(rhs.m_tuple) } {}
-	tuple_wrapper(const val_tuple_wrapper_t &rhs)
-		: m_tuple { rhs.m_tuple } {}
-	tuple_wrapper(const tuple_wrapper_wrapper_t &rhs)
-		: m_tuple { rhs.m_tuple } {}
 
-	auto &operator=(val_tuple_wrapper_t const &rhs) 
+	tuple_wrapper(tuple_wrapper const&) = default;
+	tuple_wrapper(tuple_wrapper&&) = default;
+
+	//Converts between rows with other element types, e.g. from references to values. Elements are copied from
+	//lvalue references, and moved from values or rvalue references
+	template<typename... Us, typename = std::enable_if_t<!std::is_same_v<tuple_wrapper<Us...>, tuple_wrapper> &&
+		std::is_constructible_v<std::tuple<Ts...>, std::tuple<Us...> const&>>>
+	tuple_wrapper(tuple_wrapper<Us...> const& rhs)
+		: m_tuple(rhs.m_tuple) {}
+
+	template<typename... Us, typename = std::enable_if_t<!std::is_same_v<tuple_wrapper<Us...>, tuple_wrapper> &&
+		std::is_constructible_v<std::tuple<Ts...>, std::tuple<Us...>&&>>>
+	tuple_wrapper(tuple_wrapper<Us...>&& rhs)
+		: m_tuple(std::move(rhs.m_tuple)) {}
+
+	//Binds references to the elements of a row of values, e.g. a tuple_wrapper<int&> to a tuple_wrapper<int>
+	template<typename... Us, typename = std::enable_if_t<!std::is_same_v<tuple_wrapper<Us...>, tuple_wrapper> &&
+		!std::is_constructible_v<std::tuple<Ts...>, std::tuple<Us...> const&> && (std::is_constructible_v<Ts, Us&> && ...)>>
+	tuple_wrapper(tuple_wrapper<Us...>& rhs)
+		: tuple_wrapper(rhs.m_tuple, std::index_sequence_for<Ts...> {}) {}
+
+	tuple_wrapper& operator=(tuple_wrapper const& rhs)
 	{
 		m_tuple = rhs.m_tuple;
 		return *this;
 	}
-	auto &operator=(tuple_wrapper_wrapper_t const &rhs) 
+
+	tuple_wrapper& operator=(tuple_wrapper&& rhs)
+	{
+		m_tuple = std::move(rhs.m_tuple);
+		return *this;
+	}
+
+	template<typename... Us, typename = std::enable_if_t<std::is_assignable_v<std::tuple<Ts...>&, std::tuple<Us...> const&>>>
+	tuple_wrapper& operator=(tuple_wrapper<Us...> const& rhs)
 	{
 		m_tuple = rhs.m_tuple;
 		return *this;
 	}
 
+	template<typename... Us, typename = std::enable_if_t<std::is_assignable_v<std::tuple<Ts...>&, std::tuple<Us...>&&>>>
+	tuple_wrapper& operator=(tuple_wrapper<Us...>&& rhs)
+	{
+		m_tuple = std::move(rhs.m_tuple);
+		return *this;
+	}
+
+	template<typename... Us, typename = std::enable_if_t<std::is_assignable_v<std::tuple<Ts...>&, std::tuple<Us...> const&>>>
+	tuple_wrapper& operator=(std::tuple<Us...> const& rhs)
+	{
+		m_tuple = rhs;
+		return *this;
+	}
+
+	template<typename... Us, typename = std::enable_if_t<std::is_assignable_v<std::tuple<Ts...>&, std::tuple<Us...>&&>>>
+	tuple_wrapper& operator=(std::tuple<Us...>&& rhs)
+	{
+		m_tuple = std::move(rhs);
+		return *this;
+	}
+
+	//Assignment through a const proxy, which assigns to the referenced elements. Only for tuple_wrappers of references
+	template<typename... Us, typename = std::enable_if_t<sizeof...(Us) == sizeof...(Ts) && (std::is_reference_v<Ts> && ...)>>
+	tuple_wrapper const& operator=(std::tuple<Us...> const& rhs) const
+	{
+		assign_elements(rhs, std::index_sequence_for<Ts...> {});
+		return *this;
+	}
+
+	template<typename... Us, typename = std::enable_if_t<sizeof...(Us) == sizeof...(Ts) && (std::is_reference_v<Ts> && ...)>>
+	tuple_wrapper const& operator=(std::tuple<Us...>&& rhs) const
+	{
+		assign_elements(std::move(rhs), std::index_sequence_for<Ts...> {});
+		return *this;
+	}
+
+	template<typename... Us, typename = std::enable_if_t<sizeof...(Us) == sizeof...(Ts) && (std::is_reference_v<Ts> && ...)>>
+	tuple_wrapper const& operator=(tuple_wrapper<Us...> const& rhs) const
+	{
+		return *this = rhs.m_tuple;
+	}
+
+	template<typename... Us, typename = std::enable_if_t<sizeof...(Us) == sizeof...(Ts) && (std::is_reference_v<Ts> && ...)>>
+	tuple_wrapper const& operator=(tuple_wrapper<Us...>&& rhs) const
+	{
+		return *this = std::move(rhs.m_tuple);
+	}
+
+	//Swaps the elements one by one. For tuple_wrappers of references these are the referenced elements,
+	//so swapping two rows of a container never creates a temporary row
+	friend void swap(tuple_wrapper& lhs, tuple_wrapper& rhs)
+	{
+		std::swap(lhs.m_tuple, rhs.m_tuple);
+	}
+
 	friend void swap(tuple_wrapper &&lhs, tuple_wrapper &&rhs) 
 	{
 		std::swap(lhs.m_tuple, rhs.m_tuple);
@@ -96,17 +173,65 @@ struct tuple_wrapper
 		return std::get<T&>(m_tuple);
 	}
 
+	template<typename T>
+	T const& get_elem() const
+	{
+		return std::get<T&>(m_tuple);
+	}
+
 	template<std::size_t I>
 	std::tuple_element_t<I, std::tuple<Ts...>>& get_elem()
 	{
 		return std::get<I>(m_tuple);
 	}
 
+	template<std::size_t I>
+	std::tuple_element_t<I, std::tuple<Ts...>> const& get_elem() const
+	{
+		return std::get<I>(m_tuple);
+	}
+
+	//Used by structured bindings
+	template<std::size_t I>
+	decltype(auto) get() &
+	{
+		return std::get<I>(m_tuple);
+	}
+
+	template<std::size_t I>
+	decltype(auto) get() const&
+	{
+		return std::get<I>(m_tuple);
+	}
+
+	template<std::size_t I>
+	decltype(auto) get() &&
+	{
+		return std::get<I>(std::move(m_tuple));
+	}
+
+private:
+	template<typename... Us, std::size_t... Is>
+	tuple_wrapper(std::tuple<Us...>& elems, std::index_sequence<Is...>)
+		: m_tuple(std::get<Is>(elems)...) {}
+
+	template<typename Tuple, std::size_t... Is>
+	void assign_elements(Tuple&& rhs, std::index_sequence<Is...>) const
+	{
+		((std::get<Is>(m_tuple) = std::get<Is>(std::forward<Tuple>(rhs))), ...);
+	}
 };
 
 template <class... Ts>
 tuple_wrapper(std::tuple<Ts...>)->tuple_wrapper<Ts...>;
 
+//Returns a tuple_wrapper of rvalue references to the elements row refers to. Used by multi_iterator's iter_move()
+template<typename... Ts>
+tuple_wrapper<std::remove_reference_t<Ts>&&...> move_row(tuple_wrapper<Ts...> const& row)
+{
+	return std::apply([](auto&... elems) { return std::tuple<std::remove_reference_t<Ts>&&...>(std::move(elems)...); }, row.m_tuple);
+}
+
 template <>
 struct tuple_wrapper<> {};
 
@@ -145,22 +270,40 @@ namespace std
 {
 
 template<std::size_t I, typename... Ts>
-auto get(mvg::detail::tuple_wrapper<Ts...> tpl) -> decltype(std::get<I>(tpl.m_tuple))
+decltype(auto) get(mvg::detail::tuple_wrapper<Ts...>& tpl)
+{
+	return std::get<I>(tpl.m_tuple);
+}
+
+template<std::size_t I, typename... Ts>
+decltype(auto) get(mvg::detail::tuple_wrapper<Ts...> const& tpl)
 {
 	return std::get<I>(tpl.m_tuple);
 }
 
+template<std::size_t I, typename... Ts>
+decltype(auto) get(mvg::detail::tuple_wrapper<Ts...>&& tpl)
+{
+	return std::get<I>(std::move(tpl.m_tuple));
+}
+
 template<typename T, typename... Ts>
-auto get(mvg::detail::tuple_wrapper<Ts...> tpl) -> decltype(std::get<T>(tpl.m_tuple))
+decltype(auto) get(mvg::detail::tuple_wrapper<Ts...>& tpl)
 {
 	return std::get<T>(tpl.m_tuple);
 }
 
-template <typename... Ts>
-struct remove_reference<mvg::detail::tuple_wrapper<Ts...>> 
+template<typename T, typename... Ts>
+decltype(auto) get(mvg::detail::tuple_wrapper<Ts...> const& tpl)
 {
-	using type = mvg::detail::tuple_wrapper<std::remove_reference_t<Ts>...>;
-};
+	return std::get<T>(tpl.m_tuple);
+}
+
+template<typename T, typename... Ts>
+decltype(auto) get(mvg::detail::tuple_wrapper<Ts...>&& tpl)
+{
+	return std::get<T>(std::move(tpl.m_tuple));
+}
 
 template<typename... Ts>
 struct tuple_size<mvg::detail::tuple_wrapper<Ts...>>
@@ -174,6 +317,24 @@ struct tuple_element<I, mvg::detail::tuple_wrapper<Ts...>>
 	using type = std::tuple_element_t<I, std::tuple<Ts...>>;
 };
 
+#if __cplusplus >= 202002L
+//Common types of rows, like those of std::tuple in C++23. The common reference of a row of references and a row of values
+//is a row of references, so std::ranges algorithms and views don't copy rows when they use it
+template<typename... Ts, typename... Us, template<typename> typename TQual, template<typename> typename UQual>
+	requires requires { typename mvg::detail::tuple_wrapper<std::common_reference_t<TQual<Ts>, UQual<Us>>...>; }
+struct basic_common_reference<mvg::detail::tuple_wrapper<Ts...>, mvg::detail::tuple_wrapper<Us...>, TQual, UQual>
+{
+	using type = mvg::detail::tuple_wrapper<std::common_reference_t<TQual<Ts>, UQual<Us>>...>;
+};
+
+template<typename... Ts, typename... Us>
+	requires requires { typename mvg::detail::tuple_wrapper<std::common_type_t<Ts, Us>...>; }
+struct common_type<mvg::detail::tuple_wrapper<Ts...>, mvg::detail::tuple_wrapper<Us...>>
+{
+	using type = mvg::detail::tuple_wrapper<std::common_type_t<Ts, Us>...>;
+};
+#endif
+
 } //namespace std
 
 
@@ -183,6 +344,109 @@ namespace mvg
 namespace detail
 {
 
+/*Storage for the iterators of mvg::multi_iterator. std::tuple has a user provided copy assignment operator,
+ *so it is never trivially copyable. packed_tuple is a plain aggregate, which is trivially copyable and standard layout
+ *whenever all Ts are*/
+template<typename... Ts>
+struct packed_tuple {};
+
+template<typename T>
+struct packed_tuple<T>
+{
+	T first;
+};
+
+template<typename T, typename... Rest>
+struct packed_tuple<T, Rest...>
+{
+	T first;
+	packed_tuple<Rest...> rest;
+};
+
+template<typename T, typename... Rest>
+packed_tuple<T, Rest...> make_packed_tuple(T first, Rest... rest)
+{
+	if constexpr (sizeof...(Rest) == 0)
+	{
+		return { first };
+	}
+	else
+	{
+		return { first, make_packed_tuple<Rest...>(rest...) };
+	}
+}
+
+template<std::size_t I, typename T, typename... Rest>
+constexpr auto& packed_get(packed_tuple<T, Rest...>& p)
+{
+	if constexpr (I == 0)
+	{
+		return p.first;
+	}
+	else
+	{
+		return packed_get<I - 1>(p.rest);
+	}
+}
+
+template<std::size_t I, typename T, typename... Rest>
+constexpr auto const& packed_get(packed_tuple<T, Rest...> const& p)
+{
+	if constexpr (I == 0)
+	{
+		return p.first;
+	}
+	else
+	{
+		return packed_get<I - 1>(p.rest);
+	}
+}
+
+/*Same as TupleForEach::foreach(), for a packed_tuple*/
+template<typename... Ts, typename F, typename... Args>
+void packed_foreach(packed_tuple<Ts...>& p, F&& f, Args&&... args)
+{
+	if constexpr (sizeof...(Ts) > 0)
+	{
+		f(p.first, args...);
+		if constexpr (sizeof...(Ts) > 1)
+		{
+			packed_foreach(p.rest, f, args...);
+		}
+	}
+}
+
+/*Same as TupleForEach::parallel_foreach(), for two packed_tuples of the same type*/
+template<typename... Ts, typename F>
+void packed_parallel_foreach(packed_tuple<Ts...>& a, packed_tuple<Ts...>& b, F&& f)
+{
+	if constexpr (sizeof...(Ts) > 0)
+	{
+		f(a.first, b.first);
+		if constexpr (sizeof...(Ts) > 1)
+		{
+			packed_parallel_foreach(a.rest, b.rest, f);
+		}
+	}
+}
+
+template<typename... Ts>
+bool operator==(packed_tuple<Ts...> const& a, packed_tuple<Ts...> const& b)
+{
+	if constexpr (sizeof...(Ts) == 0)
+	{
+		return true;
+	}
+	else if constexpr (sizeof...(Ts) == 1)
+	{
+		return a.first == b.first;
+	}
+	else
+	{
+		return a.first == b.first && a.rest == b.rest;
+	}
+}
+
 /*Helper struct for TupleForEach::foreach(), to increment all iterators stored in the std::tuple of iterators
  *held my mvg::multi_iterator
  **/
@@ -205,27 +469,41 @@ struct do_decrement
 	}
 };
 
+/*Helper struct for TupleForEach::foreach(), to advance all iterators by the same distance.
+ *Only used by multi_iterator::operator+=, which requires random access iterators*/
+struct do_advance
+{
+	template<typename It, typename Distance>
+	void operator()(It& it, Distance n)
+	{
+		it += n;
+	}
+};
+
 /*Type trait for determining the lowest common iterator tag
  *If there is no common type (eg std::output_iterator_tag and std::input_iterator_tag), std::input_iterator_tag is chosen
  */
 
 /*SFINAE fallback. Uses default tag (std::input_iterator_tag)*/
 template<typename = std::void_t<>, typename... Its>
-struct common_iterator_tag
+struct common_iterator_tag_impl
 {
 	using type = std::input_iterator_tag; //default tag, lowest possible
 };
 
 /*If the SFINAE inside the std::void_t<> fails, the specialization above is chosen, and type is
- *defined to st:d:input_iterator_tag*/
+ *defined to std::input_iterator_tag*/
 template<typename... Its>
-struct common_iterator_tag<
-	std::void_t<typename std::common_type<typename Its::iterator_category ...>::type>,
+struct common_iterator_tag_impl<
+	std::void_t<std::common_type_t<typename std::iterator_traits<Its>::iterator_category ...>>,
 	Its...>
 {
 	using type = std::common_type_t<typename std::iterator_traits<Its>::iterator_category ...>;
 };
 
+template<typename... Its>
+struct common_iterator_tag : public common_iterator_tag_impl<void, Its...> {};
+
 //Tag order:
 //InputIterator == OutputIterator < ForwardIterator < BidirectionalIterator < RandomAccessIterator
 //multi_iterator has a static_assert making sure the iterators are never a mix of InputIterator and OutputIterator
@@ -285,8 +563,9 @@ struct iterator_compare
 	template<typename Tpl, typename Comp, std::size_t... Is>
 	void operator()(Tpl const& a, Tpl const& b, Comp&& cmp, std::index_sequence<Is...>)
 	{
-		m_val = (cmp(std::get<0>(a), std::get<0>(b)));
-		dbg_assert(((cmp(std::get<Is>(a), std::get<Is>(b))) && ...) == m_val, "Ordering isn't equal"); //make sure all comparisons are the same
+		instr::count(stat_counter::iterator_compare);
+		m_val = (cmp(packed_get<0>(a), packed_get<0>(b)));
+		dbg_assert(((cmp(packed_get<Is>(a), packed_get<Is>(b))) && ...) == m_val, "Ordering isn't equal"); //make sure all comparisons are the same
 	}
 
 	bool value()
@@ -362,6 +641,58 @@ struct greater_or_equal
 	}
 };
 
+/*Tag type used as template argument of mvg::multi_iterator to select the index based specialization.
+ *T is the (possibly const qualified) element type of a contiguous column*/
+template<typename T>
+struct indexed_column {};
+
+/*Tag type used as template argument of mvg::multi_iterator to select the source based specialization.
+ *Source is a container whose rows can't be addressed through one pointer per column, like mvg::chunked_container.
+ *T is the (possibly const qualified) element type of a column*/
+template<typename Source, typename T>
+struct source_column {};
+
+/*Trait to check if a multi_iterator is the index based specialization*/
+template<typename It>
+struct is_indexed_iterator : public std::false_type {};
+
+template<typename... Ts>
+struct is_indexed_iterator<multi_iterator<indexed_column<Ts>...>> : public std::bool_constant<(sizeof...(Ts) > 0)> {};
+
+template<typename It>
+static constexpr bool is_indexed_iterator_v = is_indexed_iterator<It>::value;
+
+/*Trait to check if a type is any mvg::multi_iterator*/
+template<typename It>
+struct is_multi_iterator : public std::false_type {};
+
+template<typename... Its>
+struct is_multi_iterator<multi_iterator<Its...>> : public std::true_type {};
+
+template<typename It>
+static constexpr bool is_multi_iterator_v = is_multi_iterator<It>::value;
+
+/*Index of T in Ts, T must appear exactly once*/
+template<typename T, typename... Ts>
+constexpr std::size_t type_index()
+{
+	constexpr bool matches[] = { std::is_same_v<T, Ts>... };
+
+	std::size_t index = sizeof...(Ts);
+	std::size_t count = 0;
+	for (std::size_t i = 0; i < sizeof...(Ts); ++i)
+	{
+		if (matches[i])
+		{
+			index = i;
+			++count;
+		}
+	}
+	return count == 1 ? index : sizeof...(Ts);
+}
+
+template<typename T, typename... Ts>
+static constexpr bool has_unique_type_v = type_index<T, Ts...>() < sizeof...(Ts);
 
 } //namespace detail
 
@@ -379,8 +710,7 @@ public:
 	using value_type = detail::tuple_wrapper<typename std::iterator_traits<Its>::value_type...>;
 	using pointer = std::add_pointer_t<value_type>;
 	using reference = detail::tuple_wrapper<typename std::iterator_traits<Its>::reference...>;
-	using iterator_category =
-		std::common_type_t<typename std::iterator_traits<Its>::iterator_category...>; /*typename detail::common_iterator_tag<Its...>::type;*/
+	using iterator_category = typename detail::common_iterator_tag<Its...>::type;
 
 private:
 	
@@ -388,7 +718,14 @@ private:
 	using TList = TypeList<Its...>;
 	using TupleT = typename TList::TupleT;
 
-	TupleT m_iterators;
+	//Not a std::tuple, so multi_iterator is trivially copyable when all Its are
+	detail::packed_tuple<Its...> m_iterators {};
+
+	template<std::size_t... Is>
+	reference dereference(std::index_sequence<Is...>) const
+	{
+		return detail::tuple_wrapper { std::tie(*detail::packed_get<Is>(m_iterators) ...) };
+	}
 
 public:
 	template<typename... Tys>
@@ -412,42 +749,39 @@ public:
 		::value),
 		"Iterators can't be both input and output iterators!");
 
-	multi_iterator()
-	{
-	}
-
-	multi_iterator(Its... its) : m_iterators(TupleT { std::forward<Its>(its)... })
-	{
-	}
+	multi_iterator() = default;
 
-	multi_iterator(multi_iterator const& other) : m_iterators(other.m_iterators)
+	multi_iterator(Its... its) : m_iterators(detail::make_packed_tuple<Its...>(its...))
 	{
 	}
 
-	multi_iterator& operator=(multi_iterator const& other)
+	friend void swap(multi_iterator& a, multi_iterator& b)
 	{
-		m_iterators = other.m_iterators;
-		return *this;
+		detail::packed_parallel_foreach(a.m_iterators, b.m_iterators, detail::iterator_swap {});
 	}
 
-	virtual ~multi_iterator()
+	//Customization points used by std::ranges algorithms. iter_swap swaps the elements of both rows one by one,
+	//iter_move returns the row as rvalue references, so its elements are moved instead of copied
+	friend void iter_swap(multi_iterator const& a, multi_iterator const& b)
 	{
+		swap(*a, *b);
 	}
 
-	friend void swap(multi_iterator& a, multi_iterator& b)
+	friend auto iter_move(multi_iterator const& it)
 	{
-		TupleForEach::parallel_foreach(a.m_iterators, b.m_iterators, detail::iterator_swap {});
+		return detail::move_row(*it);
 	}
 
 	//increment is allowed on all iterators
 
 	multi_iterator& operator++() //pre increment
 	{
-		TupleForEach::foreach(m_iterators, detail::do_increment {});
+		detail::instr::count(detail::stat_counter::iterator_advance);
+		detail::packed_foreach(m_iterators, detail::do_increment {});
 		return *this;
 	}
 
-	multi_iterator& operator++(int) //post increment
+	multi_iterator operator++(int) //post increment
 	{
 		multi_iterator copy = *this;
 		++(*this);
@@ -456,7 +790,7 @@ public:
 
 	reference operator*()
 	{
-		return detail::tuple_wrapper { std::tie(*std::get<Its>(m_iterators) ...) };
+		return dereference(std::index_sequence_for<Its...> {});
 	}
 
 	auto operator*() const
@@ -470,7 +804,7 @@ public:
 			>
 			... //expand pack
 		> 
-		{ std::tie(*std::get<Its>(m_iterators) ...) };
+		{ dereference(std::index_sequence_for<Its...> {}).m_tuple };
 	}
 
 	//Conversion to a tuple of references to the iterators. Needed for structured bindings
@@ -480,6 +814,14 @@ public:
 		return **this;
 	}
 
+	//Returns the underlying iterator of the column at index I
+
+	template<std::size_t I>
+	std::tuple_element_t<I, TupleT> get_iterator() const
+	{
+		return detail::packed_get<I>(m_iterators);
+	}
+
 	//Following operations are only defined if the iterator is at least an InputIterator:
 	/*
 	 * ==
@@ -509,7 +851,7 @@ public:
 	//operator-> should be present on all iterators
 	pointer operator->()
 	{
-		static_assert(false, "operator-> is not supported on multi_iterator");
+		static_assert(sizeof(pointer) == 0, "operator-> is not supported on multi_iterator");
 //		return **this;
 	}
 
@@ -518,11 +860,12 @@ public:
 		static_assert(detail::is_at_least_tag<iterator_category, std::bidirectional_iterator_tag>::value,
 			"iterator_category must be at least BidirectionalIterator to use operator--");
 
-		TupleForEach::foreach(m_iterators, detail::do_decrement {});
+		detail::instr::count(detail::stat_counter::iterator_advance);
+		detail::packed_foreach(m_iterators, detail::do_decrement {});
 		return *this;
 	}
 
-	multi_iterator& operator--(int) //post decrement
+	multi_iterator operator--(int) //post decrement
 	{
 		static_assert(detail::is_at_least_tag<iterator_category, std::bidirectional_iterator_tag>::value,
 			"iterator_category must be at least BidirectionalIterator to use operator--");
@@ -537,9 +880,8 @@ public:
 		static_assert(detail::is_at_least_tag<iterator_category, std::random_access_iterator_tag>::value,
 			"iterator_category must be at least RandomAccessIterator to use operator+=");
 		
-		difference_type m = n;
-		if (m >= 0) while (m--) ++(*this);
-		else while (m++) --(*this);
+		detail::instr::count(detail::stat_counter::iterator_advance);
+		detail::packed_foreach(m_iterators, detail::do_advance {}, n);
 		return *this;
 	}
 
@@ -593,7 +935,7 @@ public:
 		static_assert(detail::is_at_least_tag<iterator_category, std::random_access_iterator_tag>::value,
 			"iterator_category must be at least RandomAccessIterator to use operator-");
 
-		return std::get<0>(a.m_iterators) - std::get<0>(b.m_iterators);
+		return detail::packed_get<0>(a.m_iterators) - detail::packed_get<0>(b.m_iterators);
 	}
 
 	auto operator[](difference_type n)
@@ -601,8 +943,7 @@ public:
 		static_assert(detail::is_at_least_tag<iterator_category, std::random_access_iterator_tag>::value,
 			"iterator_category must be at least RandomAccessIterator to use operator[]");
 
-		*this += n;
-		return **this;
+		return *(*this + n);
 	}
 
 	auto operator[](difference_type n) const
@@ -610,8 +951,7 @@ public:
 		static_assert(detail::is_at_least_tag<iterator_category, std::random_access_iterator_tag>::value,
 			"iterator_category must be at least RandomAccessIterator to use operator[]");
 
-		*this += n;
-		return **this;
+		return *(*this + n);
 	}
 
 	friend bool operator<(multi_iterator const& a, multi_iterator const& b)
@@ -651,6 +991,413 @@ public:
 	}
 }; //class multi_iterator
 
+/*\class: multi_iterator<detail::indexed_column<Ts>...>
+ *\usage: Specialization used by mvg::multi_container when all of its containers are contiguous (std::vector, std::array, ...)
+ *		  Instead of a tuple of N iterators, it stores one base pointer per column and a single shared index,
+ *		  so incrementing and comparing costs one operation regardless of the amount of columns
+*/
+template<typename... Ts>
+class multi_iterator<detail::indexed_column<Ts>...>
+{
+public:
+	//Required typedefs for iterators
+
+	using difference_type = std::ptrdiff_t;
+	using value_type = detail::tuple_wrapper<std::remove_const_t<Ts>...>;
+	using pointer = std::add_pointer_t<value_type>;
+	using reference = detail::tuple_wrapper<std::add_lvalue_reference_t<Ts>...>;
+	using iterator_category = std::random_access_iterator_tag;
+
+private:
+	using TupleT = std::tuple<std::add_pointer_t<Ts>...>;
+
+	detail::packed_tuple<std::add_pointer_t<Ts>...> m_bases {};
+	difference_type m_index = 0;
+
+	template<std::size_t... Is>
+	reference dereference(difference_type index, std::index_sequence<Is...>) const
+	{
+		return detail::tuple_wrapper { std::tie(detail::packed_get<Is>(m_bases)[index] ...) };
+	}
+
+	template<typename Other, std::size_t... Is>
+	multi_iterator(Other const& other, std::index_sequence<Is...>) : 
+		m_bases(detail::make_packed_tuple<std::add_pointer_t<Ts>...>(detail::packed_get<Is>(other.m_bases)...)), m_index(other.m_index)
+	{
+	}
+
+public:
+	template<typename... Its>
+	friend class multi_iterator;
+
+	multi_iterator() = default;
+
+	multi_iterator(std::add_pointer_t<Ts>... bases, difference_type index) : 
+		m_bases(detail::make_packed_tuple<std::add_pointer_t<Ts>...>(bases...)), m_index(index)
+	{
+	}
+
+	//Allows conversion from iterator to const_iterator
+	template<typename... Us, typename = std::enable_if_t<
+		(std::is_convertible_v<std::add_pointer_t<Us>, std::add_pointer_t<Ts>> && ...)>>
+	multi_iterator(multi_iterator<detail::indexed_column<Us>...> const& other) : 
+		multi_iterator(other, std::index_sequence_for<Ts...> {})
+	{
+	}
+
+	friend void swap(multi_iterator& a, multi_iterator& b)
+	{
+		std::swap(a.m_bases, b.m_bases);
+		std::swap(a.m_index, b.m_index);
+	}
+
+	//Customization points used by std::ranges algorithms. iter_swap swaps the elements of both rows one by one,
+	//iter_move returns the row as rvalue references, so its elements are moved instead of copied
+	friend void iter_swap(multi_iterator const& a, multi_iterator const& b)
+	{
+		swap(*a, *b);
+	}
+
+	friend auto iter_move(multi_iterator const& it)
+	{
+		return detail::move_row(*it);
+	}
+
+	multi_iterator& operator++() //pre increment
+	{
+		detail::instr::count(detail::stat_counter::iterator_advance);
+		++m_index;
+		return *this;
+	}
+
+	multi_iterator operator++(int) //post increment
+	{
+		multi_iterator copy = *this;
+		detail::instr::count(detail::stat_counter::iterator_advance);
+		++m_index;
+		return copy;
+	}
+
+	multi_iterator& operator--() //pre decrement
+	{
+		detail::instr::count(detail::stat_counter::iterator_advance);
+		--m_index;
+		return *this;
+	}
+
+	multi_iterator operator--(int) //post decrement
+	{
+		multi_iterator copy = *this;
+		detail::instr::count(detail::stat_counter::iterator_advance);
+		--m_index;
+		return copy;
+	}
+
+	reference operator*() const
+	{
+		return dereference(m_index, std::index_sequence_for<Ts...> {});
+	}
+
+	//Conversion to a tuple of references to the elements. Needed for structured bindings
+
+	operator std::tuple<std::add_lvalue_reference_t<Ts>...>() const
+	{
+		return (**this).m_tuple;
+	}
+
+	//Returns an iterator (a pointer) to the current element of the column at index I
+
+	template<std::size_t I>
+	std::tuple_element_t<I, TupleT> get_iterator() const
+	{
+		return detail::packed_get<I>(m_bases) + m_index;
+	}
+
+	//Returns the shared index into all columns
+
+	difference_type index() const
+	{
+		return m_index;
+	}
+
+	multi_iterator& operator+=(difference_type n)
+	{
+		detail::instr::count(detail::stat_counter::iterator_advance);
+		m_index += n;
+		return *this;
+	}
+
+	multi_iterator& operator-=(difference_type n)
+	{
+		detail::instr::count(detail::stat_counter::iterator_advance);
+		m_index -= n;
+		return *this;
+	}
+
+	friend multi_iterator operator+(multi_iterator const& it, difference_type n)
+	{
+		multi_iterator temp = it;
+		return temp += n;
+	}
+
+	friend multi_iterator operator+(difference_type n, multi_iterator const& it)
+	{
+		multi_iterator temp = it;
+		return temp += n;
+	}
+
+	friend multi_iterator operator-(multi_iterator const& it, difference_type n)
+	{
+		multi_iterator temp = it;
+		return temp -= n;
+	}
+
+	friend difference_type operator-(multi_iterator const& a, multi_iterator const& b)
+	{
+		dbg_assert((a.m_bases == b.m_bases), "Iterators don't refer to the same columns");
+		return a.m_index - b.m_index;
+	}
+
+	reference operator[](difference_type n) const
+	{
+		return dereference(m_index + n, std::index_sequence_for<Ts...> {});
+	}
+
+	//Iterators into the same columns only differ in their index, so only the index is compared
+
+	friend bool operator==(multi_iterator const& lhs, multi_iterator const& rhs)
+	{
+		detail::instr::count(detail::stat_counter::iterator_compare);
+		dbg_assert((lhs.m_bases == rhs.m_bases), "Iterators don't refer to the same columns");
+		return lhs.m_index == rhs.m_index;
+	}
+
+	friend bool operator!=(multi_iterator const& lhs, multi_iterator const& rhs)
+	{
+		return !(lhs == rhs);
+	}
+
+	friend bool operator<(multi_iterator const& a, multi_iterator const& b)
+	{
+		detail::instr::count(detail::stat_counter::iterator_compare);
+		return a.m_index < b.m_index;
+	}
+
+	friend bool operator>(multi_iterator const& a, multi_iterator const& b)
+	{
+		detail::instr::count(detail::stat_counter::iterator_compare);
+		return a.m_index > b.m_index;
+	}
+
+	friend bool operator<=(multi_iterator const& a, multi_iterator const& b)
+	{
+		detail::instr::count(detail::stat_counter::iterator_compare);
+		return a.m_index <= b.m_index;
+	}
+
+	friend bool operator>=(multi_iterator const& a, multi_iterator const& b)
+	{
+		detail::instr::count(detail::stat_counter::iterator_compare);
+		return a.m_index >= b.m_index;
+	}
+}; //class multi_iterator<detail::indexed_column<Ts>...>
+
+/*\class: multi_iterator<detail::source_column<Source, Ts>...>
+ *\usage: Specialization for containers that look up their rows themselves. It stores a pointer to the Source container
+ *		  and a row index, and dereferences through Source::row(index), which returns a std::tuple of references to
+ *		  the elements of that row. Source is const qualified for const iterators
+*/
+template<typename Source, typename... Ts>
+class multi_iterator<detail::source_column<Source, Ts>...>
+{
+public:
+	//Required typedefs for iterators
+
+	using difference_type = std::ptrdiff_t;
+	using value_type = detail::tuple_wrapper<std::remove_const_t<Ts>...>;
+	using pointer = std::add_pointer_t<value_type>;
+	using reference = detail::tuple_wrapper<std::add_lvalue_reference_t<Ts>...>;
+	using iterator_category = std::random_access_iterator_tag;
+
+private:
+	Source* m_source = nullptr;
+	difference_type m_index = 0;
+
+public:
+	template<typename... Its>
+	friend class multi_iterator;
+
+	multi_iterator() = default;
+
+	multi_iterator(Source* source, difference_type index) : m_source(source), m_index(index)
+	{
+	}
+
+	//Allows conversion from iterator to const_iterator
+	template<typename OtherSource, typename... Us, typename = std::enable_if_t<std::is_convertible_v<OtherSource*, Source*> &&
+		(std::is_convertible_v<std::add_pointer_t<Us>, std::add_pointer_t<Ts>> && ...)>>
+	multi_iterator(multi_iterator<detail::source_column<OtherSource, Us>...> const& other) :
+		m_source(other.m_source), m_index(other.m_index)
+	{
+	}
+
+	friend void swap(multi_iterator& a, multi_iterator& b)
+	{
+		std::swap(a.m_source, b.m_source);
+		std::swap(a.m_index, b.m_index);
+	}
+
+	//Customization points used by std::ranges algorithms. iter_swap swaps the elements of both rows one by one,
+	//iter_move returns the row as rvalue references, so its elements are moved instead of copied
+	friend void iter_swap(multi_iterator const& a, multi_iterator const& b)
+	{
+		swap(*a, *b);
+	}
+
+	friend auto iter_move(multi_iterator const& it)
+	{
+		return detail::move_row(*it);
+	}
+
+	multi_iterator& operator++() //pre increment
+	{
+		detail::instr::count(detail::stat_counter::iterator_advance);
+		++m_index;
+		return *this;
+	}
+
+	multi_iterator operator++(int) //post increment
+	{
+		multi_iterator copy = *this;
+		detail::instr::count(detail::stat_counter::iterator_advance);
+		++m_index;
+		return copy;
+	}
+
+	multi_iterator& operator--() //pre decrement
+	{
+		detail::instr::count(detail::stat_counter::iterator_advance);
+		--m_index;
+		return *this;
+	}
+
+	multi_iterator operator--(int) //post decrement
+	{
+		multi_iterator copy = *this;
+		detail::instr::count(detail::stat_counter::iterator_advance);
+		--m_index;
+		return copy;
+	}
+
+	reference operator*() const
+	{
+		return reference { m_source->row(m_index) };
+	}
+
+	//Conversion to a tuple of references to the elements. Needed for structured bindings
+
+	operator std::tuple<std::add_lvalue_reference_t<Ts>...>() const
+	{
+		return m_source->row(m_index);
+	}
+
+	//Returns the row index in the source container
+
+	difference_type index() const
+	{
+		return m_index;
+	}
+
+	multi_iterator& operator+=(difference_type n)
+	{
+		detail::instr::count(detail::stat_counter::iterator_advance);
+		m_index += n;
+		return *this;
+	}
+
+	multi_iterator& operator-=(difference_type n)
+	{
+		detail::instr::count(detail::stat_counter::iterator_advance);
+		m_index -= n;
+		return *this;
+	}
+
+	friend multi_iterator operator+(multi_iterator const& it, difference_type n)
+	{
+		multi_iterator temp = it;
+		return temp += n;
+	}
+
+	friend multi_iterator operator+(difference_type n, multi_iterator const& it)
+	{
+		multi_iterator temp = it;
+		return temp += n;
+	}
+
+	friend multi_iterator operator-(multi_iterator const& it, difference_type n)
+	{
+		multi_iterator temp = it;
+		return temp -= n;
+	}
+
+	friend difference_type operator-(multi_iterator const& a, multi_iterator const& b)
+	{
+		dbg_assert((a.m_source == b.m_source), "Iterators don't refer to the same container");
+		return a.m_index - b.m_index;
+	}
+
+	reference operator[](difference_type n) const
+	{
+		return reference { m_source->row(m_index + n) };
+	}
+
+	//Iterators into the same container only differ in their index, so only the index is compared
+
+	friend bool operator==(multi_iterator const& lhs, multi_iterator const& rhs)
+	{
+		detail::instr::count(detail::stat_counter::iterator_compare);
+		dbg_assert((lhs.m_source == rhs.m_source), "Iterators don't refer to the same container");
+		return lhs.m_index == rhs.m_index;
+	}
+
+	friend bool operator!=(multi_iterator const& lhs, multi_iterator const& rhs)
+	{
+		return !(lhs == rhs);
+	}
+
+	friend bool operator<(multi_iterator const& a, multi_iterator const& b)
+	{
+		detail::instr::count(detail::stat_counter::iterator_compare);
+		return a.m_index < b.m_index;
+	}
+
+	friend bool operator>(multi_iterator const& a, multi_iterator const& b)
+	{
+		detail::instr::count(detail::stat_counter::iterator_compare);
+		return a.m_index > b.m_index;
+	}
+
+	friend bool operator<=(multi_iterator const& a, multi_iterator const& b)
+	{
+		detail::instr::count(detail::stat_counter::iterator_compare);
+		return a.m_index <= b.m_index;
+	}
+
+	friend bool operator>=(multi_iterator const& a, multi_iterator const& b)
+	{
+		detail::instr::count(detail::stat_counter::iterator_compare);
+		return a.m_index >= b.m_index;
+	}
+}; //class multi_iterator<detail::source_column<Source, Ts>...>
+
+/*multi_iterator is passed by value everywhere, so it has to stay as cheap to copy as the iterators it holds*/
+static_assert(std::is_trivially_copyable_v<multi_iterator<int*, double const*>> && std::is_standard_layout_v<multi_iterator<int*, double const*>>,
+	"multi_iterator must be trivially copyable and standard layout when its iterators are");
+static_assert(std::is_trivially_copyable_v<multi_iterator<detail::indexed_column<int>, detail::indexed_column<double const>>> &&
+	std::is_standard_layout_v<multi_iterator<detail::indexed_column<int>, detail::indexed_column<double const>>>,
+	"Index based multi_iterator must be trivially copyable and standard layout");
+static_assert(sizeof(multi_iterator<int*, double*>) == 2 * sizeof(int*), "multi_iterator must not add storage to its iterators");
+
 } //namespace mvg
 
 
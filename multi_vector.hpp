@@ -0,0 +1,711 @@
+#ifndef MVG_MULTI_VECTOR_HPP_
+#define MVG_MULTI_VECTOR_HPP_
+
+#include <tuple>
+#include <array>
+#include <memory>
+#include <memory_resource>
+#include <new>
+#include <iterator>
+#include <algorithm>
+#include <stdexcept>
+#include <cstddef>
+
+#include "multi_iterator.hpp"
+#include "column_kernels.hpp"
+#include "column_view.hpp"
+#include "column_file.hpp"
+
+namespace mvg
+{
+
+namespace detail
+{
+
+//Every column in a structure of arrays block starts on its own cache line
+static constexpr std::size_t soa_column_alignment = 64;
+
+/*Byte offsets of the columns in a structure of arrays block holding capacity elements of every T in Ts.
+ *The columns are stored one after the other, every column is aligned to soa_column_alignment*/
+template<typename... Ts>
+struct soa_layout
+{
+	static constexpr std::size_t alignment = std::max({ soa_column_alignment, alignof(Ts)... });
+
+	std::array<std::size_t, sizeof...(Ts)> offsets;
+	std::size_t bytes;
+
+	constexpr explicit soa_layout(std::size_t capacity) : offsets {}, bytes(0)
+	{
+		constexpr std::size_t sizes[] = { sizeof(Ts)... };
+		constexpr std::size_t aligns[] = { std::max(soa_column_alignment, alignof(Ts))... };
+
+		for (std::size_t i = 0; i < sizeof...(Ts); ++i)
+		{
+			bytes = (bytes + aligns[i] - 1) / aligns[i] * aligns[i];
+			offsets[i] = bytes;
+			bytes += capacity * sizes[i];
+		}
+	}
+};
+
+} //namespace detail
+
+/*\class: multi_vector
+ *\usage: Structure of arrays container, storing one column for every T in Ts. Unlike mvg::multi_container<std::vector<Ts>...>,
+ *		  all columns are stored in a single allocation, so growing all columns costs one allocation and one relocation.
+ *		  Iterating over it gives the same mvg::multi_iterator and tuple_wrapper rows as multi_container with contiguous containers
+*/
+template<typename... Ts>
+class multi_vector
+{
+	static_assert(sizeof...(Ts) > 0, "multi_vector needs at least one column");
+
+public:
+	using iterator = multi_iterator<detail::indexed_column<Ts>...>;
+	using const_iterator = multi_iterator<detail::indexed_column<std::add_const_t<Ts>>...>;
+	using value_type = detail::tuple_wrapper<Ts...>;
+	using reference = detail::tuple_wrapper<std::add_lvalue_reference_t<Ts> ...>;
+	using const_reference = detail::tuple_wrapper<std::add_lvalue_reference_t<std::add_const_t<Ts>> ...>;
+	using pointer = std::add_pointer_t<value_type>;
+	using reverse_iterator = std::reverse_iterator<iterator>;
+	using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+	using size_type = std::size_t;
+	using difference_type = std::ptrdiff_t;
+
+	multi_vector()
+	{
+	}
+
+	//Allocates all memory from resource
+	explicit multi_vector(std::pmr::memory_resource* resource) : m_resource(resource)
+	{
+	}
+
+	multi_vector(multi_vector const& rhs)
+	{
+		copy_from(rhs, std::index_sequence_for<Ts...> {});
+	}
+
+	//Uses the memory resource of rhs, which keeps it
+	multi_vector(multi_vector&& rhs) noexcept : m_resource(rhs.m_resource)
+	{
+		swap_storage(rhs);
+	}
+
+	//Like containers using std::pmr::polymorphic_allocator, assignment keeps the memory resource of the left hand side
+	//and copies or moves the elements into memory allocated from it
+	multi_vector& operator=(multi_vector const& rhs)
+	{
+		if (this != &rhs)
+		{
+			multi_vector copy { m_resource };
+			copy.copy_from(rhs, std::index_sequence_for<Ts...> {});
+			swap_storage(copy);
+		}
+		return *this;
+	}
+
+	//Takes over the block of rhs if both use the same memory resource, and moves the elements one by one otherwise
+	multi_vector& operator=(multi_vector&& rhs)
+	{
+		if (this == &rhs)
+		{
+			return *this;
+		}
+		multi_vector moved { m_resource };
+		if (m_resource == rhs.m_resource || m_resource->is_equal(*rhs.m_resource))
+		{
+			moved.swap_storage(rhs);
+		}
+		else
+		{
+			moved.copy_from(std::move(rhs), std::index_sequence_for<Ts...> {});
+		}
+		swap_storage(moved);
+		return *this;
+	}
+
+	~multi_vector()
+	{
+		clear();
+		deallocate(m_data, m_capacity);
+	}
+
+	void swap(multi_vector& rhs) noexcept
+	{
+		std::swap(m_resource, rhs.m_resource);
+		swap_storage(rhs);
+	}
+
+	friend void swap(multi_vector& a, multi_vector& b) noexcept
+	{
+		a.swap(b);
+	}
+
+	iterator begin()
+	{
+		return make_iterator<iterator>(0, std::index_sequence_for<Ts...> {});
+	}
+
+	iterator end()
+	{
+		return make_iterator<iterator>(m_size, std::index_sequence_for<Ts...> {});
+	}
+
+	const_iterator begin() const
+	{
+		return make_iterator<const_iterator>(0, std::index_sequence_for<Ts...> {});
+	}
+
+	const_iterator end() const
+	{
+		return make_iterator<const_iterator>(m_size, std::index_sequence_for<Ts...> {});
+	}
+
+	const_iterator cbegin() const
+	{
+		return begin();
+	}
+
+	const_iterator cend() const
+	{
+		return end();
+	}
+
+	reverse_iterator rbegin()
+	{
+		return reverse_iterator { end() };
+	}
+
+	reverse_iterator rend()
+	{
+		return reverse_iterator { begin() };
+	}
+
+	const_reverse_iterator crbegin() const
+	{
+		return const_reverse_iterator { end() };
+	}
+
+	const_reverse_iterator crend() const
+	{
+		return const_reverse_iterator { begin() };
+	}
+
+	reference operator[](size_type index)
+	{
+		dbg_assert((index < m_size), "multi_vector index out of range");
+		return begin()[index];
+	}
+
+	const_reference operator[](size_type index) const
+	{
+		dbg_assert((index < m_size), "multi_vector index out of range");
+		return begin()[index];
+	}
+
+	reference at(size_type index)
+	{
+		if (index >= m_size)
+		{
+			throw std::out_of_range("multi_vector index out of range");
+		}
+		return begin()[index];
+	}
+
+	const_reference at(size_type index) const
+	{
+		if (index >= m_size)
+		{
+			throw std::out_of_range("multi_vector index out of range");
+		}
+		return begin()[index];
+	}
+
+	reference front()
+	{
+		return *begin();
+	}
+
+	const_reference front() const
+	{
+		return *begin();
+	}
+
+	reference back()
+	{
+		return begin()[m_size - 1];
+	}
+
+	const_reference back() const
+	{
+		return begin()[m_size - 1];
+	}
+
+	//Returns a pointer to the first element of the column at index I
+	template<std::size_t I>
+	std::tuple_element_t<I, std::tuple<Ts*...>> data()
+	{
+		return std::get<I>(m_columns);
+	}
+
+	template<std::size_t I>
+	std::add_pointer_t<std::add_const_t<std::tuple_element_t<I, std::tuple<Ts...>>>> data() const
+	{
+		return std::get<I>(m_columns);
+	}
+
+	std::pmr::memory_resource* resource() const
+	{
+		return m_resource;
+	}
+
+	bool empty() const
+	{
+		return m_size == 0;
+	}
+
+	size_type size() const
+	{
+		return m_size;
+	}
+
+	size_type capacity() const
+	{
+		return m_capacity;
+	}
+
+	void reserve(size_type n)
+	{
+		if (n > m_capacity)
+		{
+			reallocate(n, std::index_sequence_for<Ts...> {});
+		}
+	}
+
+	void shrink_to_fit()
+	{
+		if (m_capacity > m_size)
+		{
+			reallocate(m_size, std::index_sequence_for<Ts...> {});
+		}
+	}
+
+	void clear()
+	{
+		destroy(0, std::index_sequence_for<Ts...> {});
+	}
+
+	template<typename... Elems>
+	void push_back(std::tuple<Elems...> const& elems)
+	{
+		static_assert(sizeof...(Elems) == sizeof...(Ts), "Invalid argument count");
+		push_back_copy(elems, std::index_sequence_for<Ts...> {});
+	}
+
+	template<typename... Elems>
+	void push_back(std::tuple<Elems...>&& elems)
+	{
+		static_assert(sizeof...(Elems) == sizeof...(Ts), "Invalid argument count");
+		push_back_move(std::move(elems), std::index_sequence_for<Ts...> {});
+	}
+
+	//Every argument is a tuple holding the constructor arguments for the element of one column,
+	//eg. emplace_back(std::forward_as_tuple(1), std::forward_as_tuple("abc", 2))
+	template<typename... ArgTuples>
+	void emplace_back(ArgTuples&&... args)
+	{
+		static_assert(sizeof...(ArgTuples) == sizeof...(Ts), "Invalid argument count");
+		if (m_size == m_capacity)
+		{
+			//The arguments may refer to rows of this multi_vector, so the new row is constructed by reallocate()
+			//before the old rows are moved out
+			reallocate(grown_capacity(m_size + 1), std::index_sequence_for<Ts...> {}, std::forward<ArgTuples>(args)...);
+		}
+		else
+		{
+			construct_row(m_columns, m_size, std::index_sequence_for<Ts...> {}, std::forward<ArgTuples>(args)...);
+		}
+		++m_size;
+	}
+
+	//Same as emplace_back(), but constructs the elements before pos
+	template<typename... ArgTuples>
+	iterator emplace(const_iterator pos, ArgTuples&&... args)
+	{
+		difference_type const index = pos.index();
+		emplace_back(std::forward<ArgTuples>(args)...);
+		rotate_back(index, std::index_sequence_for<Ts...> {});
+		return begin() + index;
+	}
+
+	template<typename... Elems>
+	iterator insert(const_iterator pos, std::tuple<Elems...> const& elems)
+	{
+		difference_type const index = pos.index();
+		push_back(elems);
+		rotate_back(index, std::index_sequence_for<Ts...> {});
+		return begin() + index;
+	}
+
+	iterator erase(const_iterator pos)
+	{
+		return erase(pos, pos + 1);
+	}
+
+	iterator erase(const_iterator first, const_iterator last)
+	{
+		difference_type const index = first.index();
+		erase_range(index, last.index(), std::index_sequence_for<Ts...> {});
+		return begin() + index;
+	}
+
+	void pop_back()
+	{
+		dbg_assert((m_size > 0), "pop_back() on empty multi_vector");
+		destroy(m_size - 1, std::index_sequence_for<Ts...> {});
+	}
+
+	void resize(size_type n)
+	{
+		if (n < m_size)
+		{
+			destroy(n, std::index_sequence_for<Ts...> {});
+			return;
+		}
+		reserve(n);
+		while (m_size < n)
+		{
+			construct_row(m_columns, m_size, std::index_sequence_for<Ts...> {}, (void(sizeof(Ts)), std::tuple<> {})...);
+			++m_size;
+		}
+	}
+
+	template<typename... Elems>
+	void resize(size_type n, std::tuple<Elems...> const& elems)
+	{
+		static_assert(sizeof...(Elems) == sizeof...(Ts), "Invalid argument count");
+		if (n < m_size)
+		{
+			destroy(n, std::index_sequence_for<Ts...> {});
+			return;
+		}
+		if (n > m_capacity)
+		{
+			//elems may refer to rows of this multi_vector, which reserve() moves, so they are copied first
+			std::tuple<Ts...> const copy(elems);
+			reserve(n);
+			resize(n, copy);
+			return;
+		}
+		while (m_size < n)
+		{
+			push_back(elems);
+		}
+	}
+
+	//Returns a column_view over the columns at the indices Is, see multi_container::columns
+	template<std::size_t... Is>
+	column_view<multi_iterator<detail::indexed_column<std::tuple_element_t<Is, std::tuple<Ts...>>>...>> columns()
+	{
+		using It = multi_iterator<detail::indexed_column<std::tuple_element_t<Is, std::tuple<Ts...>>>...>;
+		return { It(std::get<Is>(m_columns)..., 0), It(std::get<Is>(m_columns)..., static_cast<difference_type>(m_size)), m_size };
+	}
+
+	template<std::size_t... Is>
+	column_view<multi_iterator<detail::indexed_column<std::add_const_t<std::tuple_element_t<Is, std::tuple<Ts...>>>>...>> columns() const
+	{
+		using It = multi_iterator<detail::indexed_column<std::add_const_t<std::tuple_element_t<Is, std::tuple<Ts...>>>>...>;
+		return { It(std::get<Is>(m_columns)..., 0), It(std::get<Is>(m_columns)..., static_cast<difference_type>(m_size)), m_size };
+	}
+
+	//Returns a column_view over the columns with the types Us, every type must appear exactly once in Ts
+	template<typename... Us>
+	auto columns()
+	{
+		static_assert((detail::has_unique_type_v<Us, Ts...> && ...), "Type must match exactly one column");
+		return columns<detail::type_index<Us, Ts...>()...>();
+	}
+
+	template<typename... Us>
+	auto columns() const
+	{
+		static_assert((detail::has_unique_type_v<Us, Ts...> && ...), "Type must match exactly one column");
+		return columns<detail::type_index<Us, Ts...>()...>();
+	}
+
+	//Writes all columns to path, see multi_container::save
+	void save(std::filesystem::path const& path) const
+	{
+		std::apply([this, &path](auto const*... columns)
+		{
+			detail::save_columns(path, m_size, columns...);
+		}, m_columns);
+	}
+
+	//Calls f(spans...) for every batch of W rows, with a batch_span per column, see multi_container::for_each_batch
+	template<std::size_t W, typename F>
+	void for_each_batch(F f)
+	{
+		std::apply([this, &f](auto... columns)
+		{
+			detail::for_each_batch<W>(m_size, f, columns...);
+		}, m_columns);
+	}
+
+	//Sum of the column at index I, integers are summed in 64 bit integers
+	template<std::size_t I>
+	auto sum() const
+	{
+		return detail::column_sum(data<I>(), m_size);
+	}
+
+	//Smallest and largest value of the column at index I. The multi_vector can't be empty
+	template<std::size_t I>
+	auto min_max() const
+	{
+		dbg_assert((m_size > 0), "min_max() on empty multi_vector");
+		return detail::column_min_max(data<I>(), m_size);
+	}
+
+	//Dot product of the columns at index I and J
+	template<std::size_t I, std::size_t J>
+	auto dot() const
+	{
+		return detail::column_dot(data<I>(), data<J>(), m_size);
+	}
+
+	//Copies the values of the column at index I for which the value in the column at index M is true to out.
+	//Returns the end of the output range
+	template<std::size_t I, std::size_t M, typename OutputIt>
+	OutputIt masked_select(OutputIt out) const
+	{
+		return detail::column_masked_select(data<I>(), data<M>(), m_size, out);
+	}
+
+private:
+	using layout_type = detail::soa_layout<Ts...>;
+
+	template<typename It, std::size_t... Is>
+	It make_iterator(size_type index, std::index_sequence<Is...>) const
+	{
+		return It(std::get<Is>(m_columns) ..., static_cast<difference_type>(index));
+	}
+
+	size_type grown_capacity(size_type required) const
+	{
+		return std::max(required, m_capacity * 2);
+	}
+
+	void* allocate(std::size_t bytes)
+	{
+		return m_resource->allocate(bytes, layout_type::alignment);
+	}
+
+	void deallocate(void* block, size_type capacity)
+	{
+		if (block)
+		{
+			m_resource->deallocate(block, layout_type(capacity).bytes, layout_type::alignment);
+		}
+	}
+
+	template<std::size_t... Is>
+	std::tuple<Ts*...> columns_of(void* block, layout_type const& layout, std::index_sequence<Is...>)
+	{
+		return std::tuple<Ts*...> { reinterpret_cast<Ts*>(static_cast<char*>(block) + layout.offsets[Is]) ... };
+	}
+
+	//Elements are copied instead of moved to a new block if moving can throw and copying is possible
+	template<typename T>
+	static constexpr bool relocates_by_copy = !std::is_nothrow_move_constructible_v<T> && std::is_copy_constructible_v<T>;
+
+	//Moves (or copies, see relocates_by_copy) count elements to uninitialized memory at to
+	template<typename T>
+	static void relocate(T* from, std::size_t count, T* to)
+	{
+		if constexpr (!relocates_by_copy<T>)
+		{
+			std::uninitialized_move_n(from, count, to);
+		}
+		else
+		{
+			std::uninitialized_copy_n(from, count, to);
+		}
+	}
+
+	//Moves all elements to a new block with room for new_capacity rows, with a single allocation.
+	//If argument tuples are given, row size() of the new block is constructed from them before the elements are moved,
+	//so they may refer to the old elements
+	template<std::size_t... Is, typename... ArgTuples>
+	void reallocate(size_type new_capacity, std::index_sequence<Is...> seq, ArgTuples&&... args)
+	{
+		constexpr bool append = sizeof...(ArgTuples) > 0;
+		if (!append && new_capacity == 0)
+		{
+			deallocate(m_data, m_capacity);
+			m_data = nullptr;
+			m_columns = std::tuple<Ts*...> {};
+			m_capacity = 0;
+			return;
+		}
+
+		layout_type const layout(new_capacity);
+		void* block = allocate(layout.bytes);
+		std::tuple<Ts*...> columns = columns_of(block, layout, seq);
+
+		if constexpr (append)
+		{
+			try
+			{
+				construct_row(columns, m_size, seq, std::forward<ArgTuples>(args)...);
+			}
+			catch (...)
+			{
+				deallocate(block, new_capacity);
+				throw;
+			}
+		}
+
+		//Columns that are copied go first, so that no column has been moved from yet when a copy throws
+		bool relocated[sizeof...(Ts)] = {};
+		try
+		{
+			((relocates_by_copy<Ts> ? (relocate(std::get<Is>(m_columns), m_size, std::get<Is>(columns)), relocated[Is] = true) : false), ...);
+			((relocates_by_copy<Ts> ? false : (relocate(std::get<Is>(m_columns), m_size, std::get<Is>(columns)), relocated[Is] = true)), ...);
+		}
+		catch (...)
+		{
+			((relocated[Is] ? (void)std::destroy_n(std::get<Is>(columns), m_size) : (void)0), ...);
+			if constexpr (append)
+			{
+				(std::destroy_at(std::get<Is>(columns) + m_size), ...);
+			}
+			deallocate(block, new_capacity);
+			throw;
+		}
+
+		(std::destroy_n(std::get<Is>(m_columns), m_size), ...);
+		deallocate(m_data, m_capacity);
+
+		m_data = block;
+		m_columns = columns;
+		m_capacity = new_capacity;
+	}
+
+	//Swaps the elements and memory, but not the memory resources
+	void swap_storage(multi_vector& rhs) noexcept
+	{
+		std::swap(m_data, rhs.m_data);
+		std::swap(m_columns, rhs.m_columns);
+		std::swap(m_size, rhs.m_size);
+		std::swap(m_capacity, rhs.m_capacity);
+	}
+
+	//Copies all rows of rhs into this empty multi_vector, or moves them if rhs is an rvalue.
+	//If an element constructor throws, the block is freed again, so that a throwing copy constructor leaks nothing
+	template<typename Rhs, std::size_t... Is>
+	void copy_from(Rhs&& rhs, std::index_sequence<Is...> seq)
+	{
+		if (rhs.m_size == 0)
+		{
+			return;
+		}
+		reallocate(rhs.m_size, seq);
+
+		std::size_t copied = 0;
+		try
+		{
+			if constexpr (std::is_rvalue_reference_v<Rhs&&>)
+			{
+				((std::uninitialized_move_n(std::get<Is>(rhs.m_columns), rhs.m_size, std::get<Is>(m_columns)), ++copied), ...);
+			}
+			else
+			{
+				((std::uninitialized_copy_n(std::get<Is>(rhs.m_columns), rhs.m_size, std::get<Is>(m_columns)), ++copied), ...);
+			}
+		}
+		catch (...)
+		{
+			((Is < copied ? (void)std::destroy_n(std::get<Is>(m_columns), rhs.m_size) : (void)0), ...);
+			reallocate(0, seq);
+			throw;
+		}
+		m_size = rhs.m_size;
+	}
+
+	template<std::size_t I, typename Args>
+	static void construct_element(std::tuple<Ts*...> const& columns, size_type index, Args&& args)
+	{
+		using T = std::tuple_element_t<I, std::tuple<Ts...>>;
+		T* where = std::get<I>(columns) + index;
+		std::apply([where](auto&&... a) { ::new (static_cast<void*>(where)) T(std::forward<decltype(a)>(a) ...); },
+			std::forward<Args>(args));
+	}
+
+	//Constructs the elements of row index of columns from the argument tuples in args. If one of the constructors throws,
+	//the elements that were already constructed are destroyed again
+	template<std::size_t... Is, typename... ArgTuples>
+	static void construct_row(std::tuple<Ts*...> const& columns, size_type index, std::index_sequence<Is...>, ArgTuples&&... args)
+	{
+		std::size_t constructed = 0;
+		try
+		{
+			((construct_element<Is>(columns, index, std::forward<ArgTuples>(args)), ++constructed), ...);
+		}
+		catch (...)
+		{
+			((Is < constructed ? std::destroy_at(std::get<Is>(columns) + index) : (void)0), ...);
+			throw;
+		}
+	}
+
+	template<typename... Elems, std::size_t... Is>
+	void push_back_copy(std::tuple<Elems...> const& elems, std::index_sequence<Is...>)
+	{
+		emplace_back(std::forward_as_tuple(std::get<Is>(elems)) ...);
+	}
+
+	template<typename... Elems, std::size_t... Is>
+	void push_back_move(std::tuple<Elems...>&& elems, std::index_sequence<Is...>)
+	{
+		emplace_back(std::forward_as_tuple(std::get<Is>(std::move(elems))) ...);
+	}
+
+	//Moves the last row to index, shifting the rows in [index, size() - 1[ back by one
+	template<std::size_t... Is>
+	void rotate_back(difference_type index, std::index_sequence<Is...>)
+	{
+		(std::rotate(std::get<Is>(m_columns) + index, std::get<Is>(m_columns) + m_size - 1, std::get<Is>(m_columns) + m_size), ...);
+	}
+
+	template<std::size_t... Is>
+	void erase_range(difference_type first, difference_type last, std::index_sequence<Is...> seq)
+	{
+		if (first == last)
+		{
+			return;
+		}
+		(std::move(std::get<Is>(m_columns) + last, std::get<Is>(m_columns) + m_size, std::get<Is>(m_columns) + first), ...);
+		destroy(m_size - (last - first), seq);
+	}
+
+	//Destroys all rows starting at index first, and sets the size to first
+	template<std::size_t... Is>
+	void destroy(size_type first, std::index_sequence<Is...>)
+	{
+		(std::destroy(std::get<Is>(m_columns) + first, std::get<Is>(m_columns) + m_size), ...);
+		m_size = first;
+	}
+
+	std::pmr::memory_resource* m_resource = std::pmr::get_default_resource();
+	void* m_data = nullptr;
+	std::tuple<Ts*...> m_columns {};
+	size_type m_size = 0;
+	size_type m_capacity = 0;
+};
+
+} //namespace mvg
+
+#endif
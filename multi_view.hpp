@@ -0,0 +1,198 @@
+#ifndef MVG_MULTI_VIEW_HPP_
+#define MVG_MULTI_VIEW_HPP_
+
+#include "multi_iterator.hpp"
+
+#if __cplusplus >= 202002L
+
+#include <ranges>
+#include <tuple>
+#include <iterator>
+#include <algorithm>
+#include <cstddef>
+
+namespace mvg
+{
+
+namespace detail
+{
+
+template<bool Const, typename V>
+using maybe_const_t = std::conditional_t<Const, V const, V>;
+
+//multi_iterator dereferences with std::tie, so every column has to give lvalues
+template<typename V>
+concept multi_view_column = std::ranges::forward_range<V> && std::is_lvalue_reference_v<std::ranges::range_reference_t<V>>;
+
+} //namespace detail
+
+/*\class: multi_view
+ *\usage: Non owning view over several existing ranges, iterated row by row like a multi_container, returned by mvg::views::multi().
+ *		  Nothing is copied: containers passed as lvalues are referenced, rvalue ranges are moved into the view.
+ *		  Its iterators are multi_iterators over the iterators of all ranges, its end() is a sentinel which only compares
+ *		  the column of the shortest range when all ranges are sized, and any column reaching its end otherwise,
+ *		  so ranges of different length are safe. It is a random_access_range when all ranges are random access,
+ *		  and a sized_range when all ranges are sized. Every range must give lvalue references to its elements
+*/
+template<std::ranges::view... Vs>
+	requires (sizeof...(Vs) > 0) && (detail::multi_view_column<Vs> && ...)
+class multi_view : public std::ranges::view_interface<multi_view<Vs...>>
+{
+	template<bool Const>
+	using iterator_type = multi_iterator<std::ranges::iterator_t<detail::maybe_const_t<Const, Vs>>...>;
+
+	//Column index of a sentinel that compares all columns
+	static constexpr std::size_t any_column = sizeof...(Vs);
+
+public:
+	template<bool Const>
+	class sentinel
+	{
+		using iterator = iterator_type<Const>;
+
+	public:
+		sentinel() = default;
+
+		sentinel(std::tuple<std::ranges::sentinel_t<detail::maybe_const_t<Const, Vs>>...> ends, std::size_t column) :
+			m_ends(std::move(ends)), m_column(column)
+		{
+		}
+
+		friend bool operator==(iterator const& it, sentinel const& s)
+		{
+			return s.reached(it, std::index_sequence_for<Vs...> {});
+		}
+
+		friend std::ptrdiff_t operator-(sentinel const& s, iterator const& it)
+			requires (std::sized_sentinel_for<std::ranges::sentinel_t<detail::maybe_const_t<Const, Vs>>,
+				std::ranges::iterator_t<detail::maybe_const_t<Const, Vs>>> && ...)
+		{
+			return s.distance(it, std::index_sequence_for<Vs...> {});
+		}
+
+		friend std::ptrdiff_t operator-(iterator const& it, sentinel const& s)
+			requires (std::sized_sentinel_for<std::ranges::sentinel_t<detail::maybe_const_t<Const, Vs>>,
+				std::ranges::iterator_t<detail::maybe_const_t<Const, Vs>>> && ...)
+		{
+			return -(s - it);
+		}
+
+	private:
+		template<std::size_t... Is>
+		bool reached(iterator const& it, std::index_sequence<Is...>) const
+		{
+			if (m_column == any_column)
+			{
+				return ((it.template get_iterator<Is>() == std::get<Is>(m_ends)) || ...);
+			}
+			return ((m_column == Is && it.template get_iterator<Is>() == std::get<Is>(m_ends)) || ...);
+		}
+
+		//Only used when all ranges are sized, so m_column is the shortest column
+		template<std::size_t... Is>
+		std::ptrdiff_t distance(iterator const& it, std::index_sequence<Is...>) const
+		{
+			std::ptrdiff_t d = 0;
+			((m_column == Is ? (d = static_cast<std::ptrdiff_t>(std::get<Is>(m_ends) - it.template get_iterator<Is>()), true) : false) || ...);
+			return d;
+		}
+
+		std::tuple<std::ranges::sentinel_t<detail::maybe_const_t<Const, Vs>>...> m_ends {};
+		std::size_t m_column = any_column;
+	};
+
+	multi_view() = default;
+
+	constexpr explicit multi_view(Vs... views) : m_views(std::move(views)...)
+	{
+	}
+
+	iterator_type<false> begin()
+	{
+		return std::apply([](auto&... views) { return iterator_type<false>(std::ranges::begin(views)...); }, m_views);
+	}
+
+	iterator_type<true> begin() const
+		requires (detail::multi_view_column<Vs const> && ...)
+	{
+		return std::apply([](auto const&... views) { return iterator_type<true>(std::ranges::begin(views)...); }, m_views);
+	}
+
+	sentinel<false> end()
+	{
+		return make_sentinel<false>(m_views, std::index_sequence_for<Vs...> {});
+	}
+
+	sentinel<true> end() const
+		requires (detail::multi_view_column<Vs const> && ...)
+	{
+		return make_sentinel<true>(m_views, std::index_sequence_for<Vs...> {});
+	}
+
+	//Size of the shortest range
+	std::size_t size()
+		requires (std::ranges::sized_range<Vs> && ...)
+	{
+		return std::apply([](auto&... views) { return std::min({ static_cast<std::size_t>(std::ranges::size(views))... }); }, m_views);
+	}
+
+	std::size_t size() const
+		requires (std::ranges::sized_range<Vs const> && ...)
+	{
+		return std::apply([](auto const&... views) { return std::min({ static_cast<std::size_t>(std::ranges::size(views))... }); }, m_views);
+	}
+
+private:
+	//Index of the shortest range when all ranges are sized, any_column otherwise
+	template<typename Views, std::size_t... Is>
+	static std::size_t shortest_column(Views& views, std::index_sequence<Is...>)
+	{
+		if constexpr ((std::ranges::sized_range<decltype(std::get<Is>(views))> && ...))
+		{
+			std::size_t const sizes[] = { static_cast<std::size_t>(std::ranges::size(std::get<Is>(views)))... };
+			return static_cast<std::size_t>(std::min_element(std::begin(sizes), std::end(sizes)) - std::begin(sizes));
+		}
+		else
+		{
+			return any_column;
+		}
+	}
+
+	template<bool Const, typename Views, std::size_t... Is>
+	static sentinel<Const> make_sentinel(Views& views, std::index_sequence<Is...> seq)
+	{
+		return sentinel<Const>({ std::ranges::end(std::get<Is>(views))... }, shortest_column(views, seq));
+	}
+
+	std::tuple<Vs...> m_views;
+};
+
+template<typename... Rs>
+multi_view(Rs&&...) -> multi_view<std::views::all_t<Rs>...>;
+
+namespace views
+{
+
+struct multi_fn
+{
+	template<std::ranges::viewable_range... Rs>
+		requires (sizeof...(Rs) > 0)
+	constexpr auto operator()(Rs&&... ranges) const
+	{
+		return multi_view<std::views::all_t<Rs>...>(std::views::all(std::forward<Rs>(ranges))...);
+	}
+};
+
+//mvg::views::multi(r1, r2, ...) returns a mvg::multi_view over the ranges r1, r2, ...
+inline constexpr multi_fn multi {};
+
+} //namespace views
+
+} //namespace mvg
+
+template<typename... Vs>
+inline constexpr bool std::ranges::enable_borrowed_range<mvg::multi_view<Vs...>> = (std::ranges::enable_borrowed_range<Vs> && ...);
+
+#endif
+
+#endif
@@ -0,0 +1,328 @@
+#ifndef MVG_PARALLEL_HPP_
+#define MVG_PARALLEL_HPP_
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "multi_container.hpp"
+
+namespace mvg
+{
+
+namespace detail
+{
+
+//Smallest amount of rows worth giving its own thread in the parallel algorithms of mvg::multi_container
+static constexpr std::size_t parallel_min_rows = 4096;
+
+//Largest amount of threads used by one call of a parallel algorithm, set with mvg::set_parallel_threads(). 0 is no limit
+inline std::atomic<unsigned>& parallel_thread_limit()
+{
+	static std::atomic<unsigned> limit { 0 };
+	return limit;
+}
+
+inline std::size_t parallel_thread_count()
+{
+	unsigned const hardware = std::max(1u, std::thread::hardware_concurrency());
+	unsigned const limit = parallel_thread_limit().load(std::memory_order_relaxed);
+	return limit != 0 ? std::min(limit, hardware) : hardware;
+}
+
+/*\class: thread_pool
+ *\usage: Worker threads for the parallel algorithms of mvg::multi_container. shared() creates one pool on first use,
+ *		  so no thread is started per call. Tasks are run in the order they were submitted. A thread waiting for a task
+ *		  runs queued tasks itself in the meantime, so the parallel algorithms can be nested without running out of workers
+*/
+class thread_pool
+{
+public:
+	explicit thread_pool(std::size_t workers)
+	{
+		try
+		{
+			m_workers.reserve(workers);
+			for (std::size_t i = 0; i < workers; ++i)
+			{
+				m_workers.emplace_back([this] { work(); });
+			}
+		}
+		catch (...)
+		{
+			stop();
+			throw;
+		}
+	}
+
+	thread_pool(thread_pool const&) = delete;
+	thread_pool& operator=(thread_pool const&) = delete;
+
+	~thread_pool()
+	{
+		stop();
+	}
+
+	//The pool used by mvg::multi_container. It has one worker less than std::thread::hardware_concurrency(),
+	//because the calling thread processes a chunk too
+	static thread_pool& shared()
+	{
+		static thread_pool pool(std::max(1u, std::thread::hardware_concurrency()) - 1);
+		return pool;
+	}
+
+	//Queues f to run on a worker. Its result or exception is returned through the future
+	template<typename F>
+	auto submit(F f) -> std::future<decltype(f())>
+	{
+		using R = decltype(f());
+		auto task = std::make_shared<std::packaged_task<R()>>(std::move(f));
+		std::future<R> result = task->get_future();
+		{
+			std::lock_guard<std::mutex> lock(m_mutex);
+			m_tasks.emplace_back([task] { (*task)(); });
+		}
+		m_wake.notify_one();
+		return result;
+	}
+
+	//Returns the result of future, running queued tasks on the calling thread until it is ready
+	template<typename R>
+	R wait(std::future<R>& future)
+	{
+		while (future.wait_for(std::chrono::seconds(0)) != std::future_status::ready && run_one())
+		{
+		}
+		return future.get();
+	}
+
+private:
+	//Runs the next queued task on the calling thread. Returns false if there was none
+	bool run_one()
+	{
+		std::function<void()> task;
+		{
+			std::lock_guard<std::mutex> lock(m_mutex);
+			if (m_tasks.empty())
+			{
+				return false;
+			}
+			task = std::move(m_tasks.front());
+			m_tasks.pop_front();
+		}
+		task();
+		return true;
+	}
+
+	void work()
+	{
+		for (;;)
+		{
+			std::function<void()> task;
+			{
+				std::unique_lock<std::mutex> lock(m_mutex);
+				m_wake.wait(lock, [this] { return m_stop || !m_tasks.empty(); });
+				if (m_tasks.empty())
+				{
+					return;
+				}
+				task = std::move(m_tasks.front());
+				m_tasks.pop_front();
+			}
+			task();
+		}
+	}
+
+	//Lets the workers finish the queued tasks, and joins them
+	void stop()
+	{
+		{
+			std::lock_guard<std::mutex> lock(m_mutex);
+			m_stop = true;
+		}
+		m_wake.notify_all();
+		for (std::thread& worker : m_workers)
+		{
+			worker.join();
+		}
+		m_workers.clear();
+	}
+
+	std::mutex m_mutex;
+	std::condition_variable m_wake;
+	std::deque<std::function<void()>> m_tasks;
+	bool m_stop = false;
+	std::vector<std::thread> m_workers;
+};
+
+/*Splits [0, n[ into at most parallel_thread_count() chunks of at least parallel_min_rows rows,
+ *and calls f(first, last) for every chunk. f is not copied, all chunks call the same f. The first chunk is processed on the calling thread, the others on the
+ *workers of thread_pool::shared(). Returns the results of f in chunk order. Once all chunks are done,
+ *the first exception thrown by f is rethrown on the calling thread*/
+template<typename F>
+auto parallel_chunks(std::size_t n, F const& f)
+{
+	using R = decltype(f(std::size_t {}, std::size_t {}));
+
+	std::size_t const chunks = std::min(parallel_thread_count(), std::max<std::size_t>(1, n / parallel_min_rows));
+	auto const chunk_first = [n, chunks](std::size_t c) { return c * (n / chunks) + std::min(c, n % chunks); };
+
+	std::vector<std::future<R>> futures;
+	futures.reserve(chunks);
+	std::packaged_task<R()> own([&f, &chunk_first] { return f(0, chunk_first(1)); });
+	futures.push_back(own.get_future());
+	thread_pool* const pool = chunks > 1 ? &thread_pool::shared() : nullptr;
+	for (std::size_t c = 1; c < chunks; ++c)
+	{
+		futures.push_back(pool->submit([&f, first = chunk_first(c), last = chunk_first(c + 1)] { return f(first, last); }));
+	}
+	own();
+
+	//Every chunk has to be done before returning or throwing, since they refer to f
+	std::exception_ptr error;
+	auto const keep_first_error = [&error]
+	{
+		if (!error)
+		{
+			error = std::current_exception();
+		}
+	};
+
+	if constexpr (std::is_void_v<R>)
+	{
+		for (auto& future : futures)
+		{
+			try
+			{
+				pool ? pool->wait(future) : future.get();
+			}
+			catch (...)
+			{
+				keep_first_error();
+			}
+		}
+		if (error)
+		{
+			std::rethrow_exception(error);
+		}
+	}
+	else
+	{
+		std::vector<R> results;
+		results.reserve(chunks);
+		for (auto& future : futures)
+		{
+			try
+			{
+				results.push_back(pool ? pool->wait(future) : future.get());
+			}
+			catch (...)
+			{
+				keep_first_error();
+			}
+		}
+		if (error)
+		{
+			std::rethrow_exception(error);
+		}
+		return results;
+	}
+}
+
+/*\class: parallel_rows
+ *\usage: The parallel algorithms of mvg::multi_container, which only declares this class, so it doesn't pull in <thread> and
+ *		  <future>. Container needs random access iterators
+*/
+template<typename Container>
+struct parallel_rows
+{
+	using iterator = typename Container::iterator;
+
+	template<typename F>
+	static void for_each_row(Container& c, F&& f)
+	{
+		iterator const first = c.begin();
+		parallel_chunks(c.size(), [&first, &f](std::size_t lo, std::size_t hi)
+		{
+			for (iterator it = first + lo, last = first + hi; it != last; ++it)
+			{
+				f(*it);
+			}
+		});
+	}
+
+	template<typename RandomIt, typename F>
+	static RandomIt transform_rows(Container& c, RandomIt d_first, F&& f)
+	{
+		iterator const first = c.begin();
+		std::size_t const n = c.size();
+		parallel_chunks(n, [&first, &f, &d_first](std::size_t lo, std::size_t hi)
+		{
+			RandomIt out = d_first + lo;
+			for (iterator it = first + lo, last = first + hi; it != last; ++it, ++out)
+			{
+				*out = f(*it);
+			}
+		});
+		return d_first + n;
+	}
+
+	template<typename T, typename Reduce, typename Transform>
+	static T reduce_rows(Container& c, T init, Reduce&& reduce, Transform&& transform)
+	{
+		std::size_t const n = c.size();
+		if (n == 0)
+		{
+			return init;
+		}
+
+		iterator const first = c.begin();
+		auto partials = parallel_chunks(n, [&first, &reduce, &transform](std::size_t lo, std::size_t hi)
+		{
+			iterator it = first + lo;
+			T acc = transform(*it);
+			for (iterator last = first + hi; ++it != last;)
+			{
+				acc = reduce(std::move(acc), transform(*it));
+			}
+			return acc;
+		});
+
+		for (T& partial : partials)
+		{
+			init = reduce(std::move(init), std::move(partial));
+		}
+		return init;
+	}
+};
+
+} //namespace detail
+
+//Limits the parallel algorithms of multi_container to threads threads per call, including the calling thread.
+//0 (the default) and values above std::thread::hardware_concurrency() use all hardware threads. Affects calls started after it returns
+inline void set_parallel_threads(unsigned threads)
+{
+	detail::parallel_thread_limit().store(threads, std::memory_order_relaxed);
+}
+
+//Amount of threads the parallel algorithms use per call
+inline std::size_t parallel_threads()
+{
+	return detail::parallel_thread_count();
+}
+
+} //namespace mvg
+
+#endif
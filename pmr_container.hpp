@@ -0,0 +1,70 @@
+#ifndef MVG_PMR_CONTAINER_HPP_
+#define MVG_PMR_CONTAINER_HPP_
+
+#include <cstddef>
+#include <memory_resource>
+#include <vector>
+
+#include "multi_container.hpp"
+
+namespace mvg
+{
+
+namespace pmr
+{
+
+//multi_container of std::pmr::vector's, all allocating from the memory resource given to the constructor
+template<typename... Ts>
+using multi_container = mvg::multi_container<std::pmr::vector<Ts>...>;
+
+/*\class: arena_container
+ *\usage: mvg::pmr::multi_container that allocates from its own std::pmr::monotonic_buffer_resource.
+ *		  Allocations are never freed one by one, release() frees all memory in one go.
+ *		  Meant for short lived containers, for example a table that is only used while handling a single request
+*/
+template<typename... Ts>
+class arena_container
+{
+public:
+	using container_type = multi_container<Ts...>;
+
+	explicit arena_container(std::size_t initial_size = 4096) : m_arena(initial_size), m_container(&m_arena)
+	{
+	}
+
+	//Allocates from buffer first, and only allocates from the default resource when buffer is full
+	arena_container(void* buffer, std::size_t size) : m_arena(buffer, size), m_container(&m_arena)
+	{
+	}
+
+	arena_container(arena_container const&) = delete;
+	arena_container& operator=(arena_container const&) = delete;
+
+	container_type& container()
+	{
+		return m_container;
+	}
+
+	container_type const& container() const
+	{
+		return m_container;
+	}
+
+	//Destroys all elements and frees all memory of the arena at once
+	void release()
+	{
+		m_container = container_type(&m_arena);
+		m_arena.release();
+	}
+
+private:
+	//Declared before the container, so it's destroyed after it
+	std::pmr::monotonic_buffer_resource m_arena;
+	container_type m_container;
+};
+
+} //namespace pmr
+
+} //namespace mvg
+
+#endif
@@ -0,0 +1,220 @@
+#ifndef MVG_SORTED_INDEX_HPP_
+#define MVG_SORTED_INDEX_HPP_
+
+#include <tuple>
+#include <vector>
+#include <iterator>
+#include <algorithm>
+#include <numeric>
+#include <functional>
+#include <cstddef>
+
+#include "multi_container.hpp"
+#include "multi_vector.hpp"
+#include "column_view.hpp"
+
+namespace mvg
+{
+
+namespace detail
+{
+
+/*Access to single elements of a container by row, used by mvg::sorted_index. Element types are in value_types*/
+template<typename Container>
+struct row_access;
+
+template<typename... Cs>
+struct row_access<multi_container<Cs...>>
+{
+	static_assert((std::is_base_of_v<std::random_access_iterator_tag, typename std::iterator_traits<typename Cs::iterator>::iterator_category> && ...),
+		"All containers must support random access");
+
+	using value_types = std::tuple<container_value_t<Cs>...>;
+
+	template<std::size_t J>
+	static auto const& element(multi_container<Cs...> const& c, std::size_t row)
+	{
+		return std::get<J>(c.data())[row];
+	}
+};
+
+template<typename... Ts>
+struct row_access<multi_vector<Ts...>>
+{
+	using value_types = std::tuple<Ts...>;
+
+	template<std::size_t J>
+	static auto const& element(multi_vector<Ts...> const& c, std::size_t row)
+	{
+		return c.template data<J>()[row];
+	}
+};
+
+template<typename Source, typename Tuple>
+struct const_source_iterator;
+
+template<typename Source, typename... Vs>
+struct const_source_iterator<Source, std::tuple<Vs...>>
+{
+	using type = multi_iterator<source_column<Source, std::add_const_t<Vs>>...>;
+};
+
+} //namespace detail
+
+/*\class: sorted_index
+ *\usage: Secondary index over the column at index I of a multi_container or multi_vector, for range queries on that column.
+ *		  It stores a permutation of the row numbers ordered by key (rows with equal keys in row order), the rows themselves
+ *		  are never moved. The permutation is brought up to date by the first query after a change: rows appended since
+ *		  then are sorted on their own and merged into it, any other change must be reported with invalidate(),
+ *		  after which it is rebuilt. Queries return column_views over the matching rows in key order, which stay valid
+ *		  until the next query that brings the index up to date. The container must outlive the index.
+ *		  All containers of a multi_container must support random access
+*/
+template<std::size_t I, typename Container, typename Compare = std::less<>>
+class sorted_index
+{
+	using access = detail::row_access<Container>;
+	using value_types = typename access::value_types;
+
+	static_assert(I < std::tuple_size_v<value_types>, "Key index out of range");
+
+public:
+	using container_type = Container;
+	using key_type = std::tuple_element_t<I, value_types>;
+	using key_compare = Compare;
+	using iterator = typename detail::const_source_iterator<sorted_index const, value_types>::type;
+	using const_iterator = iterator;
+	using view_type = column_view<iterator>;
+	using size_type = std::size_t;
+	using difference_type = std::ptrdiff_t;
+
+	//The permutation is built by the first query
+	explicit sorted_index(Container const& container, Compare comp = Compare {}) : m_container(&container), m_comp(std::move(comp))
+	{
+	}
+
+	//Marks the permutation as outdated after a change other than appending rows, like erasing, inserting,
+	//sorting or modifying keys. The next query rebuilds it
+	void invalidate()
+	{
+		m_valid = false;
+	}
+
+	//Brings the permutation up to date with the container. Called by every query
+	void refresh()
+	{
+		size_type const n = m_container->size();
+		if (!m_valid || n < m_indexed)
+		{
+			m_order.resize(n);
+			std::iota(m_order.begin(), m_order.end(), size_type(0));
+			std::stable_sort(m_order.begin(), m_order.end(), row_less());
+			m_indexed = n;
+			m_valid = true;
+		}
+		else if (n > m_indexed)
+		{
+			auto const middle = static_cast<difference_type>(m_indexed);
+			m_order.resize(n);
+			std::iota(m_order.begin() + middle, m_order.end(), m_indexed);
+			std::stable_sort(m_order.begin() + middle, m_order.end(), row_less());
+			std::inplace_merge(m_order.begin(), m_order.begin() + middle, m_order.end(), row_less());
+			m_indexed = n;
+		}
+	}
+
+	//Returns all rows in key order
+	view_type all()
+	{
+		refresh();
+		return view(0, m_order.size());
+	}
+
+	//Returns the rows whose key is equal to key
+	view_type equal_range(key_type const& key)
+	{
+		refresh();
+		auto const range = std::equal_range(m_order.begin(), m_order.end(), key, key_less());
+		return view(range.first - m_order.begin(), range.second - m_order.begin());
+	}
+
+	//Returns the rows whose key lies in [lo, hi]
+	view_type range(key_type const& lo, key_type const& hi)
+	{
+		refresh();
+		auto const first = std::lower_bound(m_order.begin(), m_order.end(), lo, key_less());
+		auto const last = m_comp(hi, lo) ? first : std::upper_bound(first, m_order.end(), hi, key_less());
+		return view(first - m_order.begin(), last - m_order.begin());
+	}
+
+	//Returns the row numbers in key order
+	std::vector<size_type> const& order()
+	{
+		refresh();
+		return m_order;
+	}
+
+	//Returns references to the elements of the row at position pos of the permutation. Used by the iterators
+	auto row(difference_type pos) const
+	{
+		return row_at(m_order[static_cast<size_type>(pos)], std::make_index_sequence<std::tuple_size_v<value_types>> {});
+	}
+
+	Container const& container() const
+	{
+		return *m_container;
+	}
+
+private:
+	key_type const& key_at(size_type row) const
+	{
+		return access::template element<I>(*m_container, row);
+	}
+
+	template<std::size_t... Js>
+	auto row_at(size_type row, std::index_sequence<Js...>) const
+	{
+		return std::tuple<decltype(access::template element<Js>(*m_container, row))...>(access::template element<Js>(*m_container, row)...);
+	}
+
+	auto row_less() const
+	{
+		return [this](size_type a, size_type b) { return m_comp(key_at(a), key_at(b)); };
+	}
+
+	//Compares a row with a key in both orders, for std::lower_bound and std::upper_bound
+	struct key_compare_rows
+	{
+		sorted_index const* self;
+
+		bool operator()(size_type row, key_type const& key) const
+		{
+			return self->m_comp(self->key_at(row), key);
+		}
+
+		bool operator()(key_type const& key, size_type row) const
+		{
+			return self->m_comp(key, self->key_at(row));
+		}
+	};
+
+	key_compare_rows key_less() const
+	{
+		return key_compare_rows { this };
+	}
+
+	view_type view(difference_type first, difference_type last) const
+	{
+		return view_type(iterator(this, first), iterator(this, last), static_cast<size_type>(last - first));
+	}
+
+	Container const* m_container;
+	Compare m_comp;
+	std::vector<size_type> m_order;
+	size_type m_indexed = 0;
+	bool m_valid = false;
+};
+
+} //namespace mvg
+
+#endif
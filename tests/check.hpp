@@ -0,0 +1,56 @@
+#ifndef MVG_TESTS_CHECK_HPP_
+#define MVG_TESTS_CHECK_HPP_
+
+/*Minimal assertions for the tests in this directory. A failed MVG_CHECK prints the condition and its location and the test
+ *continues, so one run reports every failure. main() returns check_result(), which fails the test if any check failed.
+ *Unlike assert() the checks stay active in release builds*/
+#include <cstdio>
+#include <cstdlib>
+
+namespace mvg_test
+{
+
+inline int& failures()
+{
+	static int count = 0;
+	return count;
+}
+
+inline void report(char const* what, char const* file, int line)
+{
+	std::fprintf(stderr, "%s:%d: check failed: %s\n", file, line, what);
+	++failures();
+}
+
+inline int check_result()
+{
+	if (failures() > 0)
+	{
+		std::fprintf(stderr, "%d checks failed\n", failures());
+		return EXIT_FAILURE;
+	}
+	return EXIT_SUCCESS;
+}
+
+} //namespace mvg_test
+
+//Variadic, so that conditions may hold commas, like t.dot<0, 1>() == 0
+#define MVG_CHECK(...) ((__VA_ARGS__) ? (void)0 : mvg_test::report(#__VA_ARGS__, __FILE__, __LINE__))
+
+//Checks that expr throws an exception of type Exception
+#define MVG_CHECK_THROWS(expr, Exception) \
+	do \
+	{ \
+		bool thrown_ = false; \
+		try \
+		{ \
+			(void)(expr); \
+		} \
+		catch (Exception const&) \
+		{ \
+			thrown_ = true; \
+		} \
+		MVG_CHECK(thrown_ && #expr " throws " #Exception); \
+	} while (false)
+
+#endif
@@ -0,0 +1,170 @@
+/*pop_front_block() and retain() drop whole blocks at the front of a chunked_container. The remaining rows must keep their
+ *values and addresses, row numbers keep counting up, and appending must go on where it left off, also once it was emptied*/
+#include <cstddef>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <utility>
+
+#include "chunked_container.hpp"
+
+#include "check.hpp"
+
+namespace
+{
+
+using table = mvg::basic_chunked_container<4, int, std::string, std::unique_ptr<int>>;
+
+void append(table& t, int first, int last)
+{
+	for (int i = first; i < last; ++i)
+	{
+		t.push_back(std::make_tuple(i, std::to_string(i), std::make_unique<int>(i)));
+	}
+}
+
+//Checks that t holds the rows first to last - 1, through operator[], the iterators and for_each_block()
+bool holds(table const& t, int first, int last)
+{
+	if (t.size() != static_cast<std::size_t>(last - first) || t.empty() != (first == last))
+	{
+		return false;
+	}
+	for (int i = first; i < last; ++i)
+	{
+		auto const row = t[static_cast<std::size_t>(i - first)];
+		if (std::get<0>(row) != i || std::get<1>(row) != std::to_string(i) || *std::get<2>(row) != i)
+		{
+			return false;
+		}
+	}
+	int expected = first;
+	for (auto const& row : t)
+	{
+		if (std::get<0>(row) != expected++)
+		{
+			return false;
+		}
+	}
+	std::size_t rows = 0;
+	bool values = true;
+	t.for_each_block([&](std::size_t count, int const* ids, std::string const*, std::unique_ptr<int> const*)
+	{
+		for (std::size_t j = 0; j < count; ++j)
+		{
+			values = values && ids[j] == first + static_cast<int>(rows + j);
+		}
+		rows += count;
+	});
+	return values && expected == last && rows == t.size() && t.block_count() == (t.size() + 3) / 4;
+}
+
+void pop_front_block()
+{
+	table t;
+	append(t, 0, 10);
+	int const* third_block = &std::get<0>(t[8]);
+	auto const row_9 = t.begin() + 9;
+
+	t.pop_front_block();
+	MVG_CHECK(holds(t, 4, 10));
+	MVG_CHECK(t.begin().index() == 4);
+	//Appending doesn't move rows, and removing blocks at the front doesn't move the others
+	MVG_CHECK(&std::get<0>(t[4]) == third_block);
+	MVG_CHECK(std::get<0>(*row_9) == 9);
+	MVG_CHECK(row_9 - t.begin() == 5);
+
+	t.pop_front_block();
+	MVG_CHECK(holds(t, 8, 10));
+	MVG_CHECK(&std::get<0>(t.front()) == third_block);
+
+	//The last block is partly filled
+	t.pop_front_block();
+	MVG_CHECK(holds(t, 10, 10));
+	MVG_CHECK(t.block_count() == 0);
+
+	//Emptied by pop_front_block(), appending starts a new block
+	append(t, 10, 15);
+	MVG_CHECK(holds(t, 10, 15));
+	MVG_CHECK(std::get<1>(t.back()) == "14");
+	MVG_CHECK_THROWS(t.at(5), std::out_of_range);
+
+	//pop_back() into the block before
+	t.pop_back();
+	t.pop_back();
+	MVG_CHECK(holds(t, 10, 13));
+	append(t, 13, 17);
+	MVG_CHECK(holds(t, 10, 17));
+}
+
+void retain()
+{
+	table t;
+	append(t, 0, 22);
+
+	//Nothing to drop: fewer rows would be left than asked for
+	t.retain(22);
+	MVG_CHECK(holds(t, 0, 22));
+	t.retain(19);
+	MVG_CHECK(holds(t, 0, 22));
+
+	//Drops blocks as long as at least the asked rows are left
+	t.retain(18);
+	MVG_CHECK(holds(t, 4, 22));
+	t.retain(7);
+	MVG_CHECK(holds(t, 12, 22));
+	t.retain(6);
+	MVG_CHECK(holds(t, 16, 22));
+
+	//The last block is never dropped, even with retain(0)
+	t.retain(0);
+	MVG_CHECK(holds(t, 20, 22));
+	t.retain(0);
+	MVG_CHECK(holds(t, 20, 22));
+
+	append(t, 22, 30);
+	MVG_CHECK(holds(t, 20, 30));
+	t.retain(5);
+	MVG_CHECK(holds(t, 24, 30));
+
+	//A sliding window, like an ingest buffer
+	table window;
+	for (int i = 0; i < 100; ++i)
+	{
+		append(window, i, i + 1);
+		window.retain(10);
+		MVG_CHECK(window.size() >= 10 || window.size() == static_cast<std::size_t>(i + 1));
+		MVG_CHECK(window.size() < 14);
+		MVG_CHECK(std::get<0>(window.back()) == i);
+	}
+	MVG_CHECK(holds(window, 88, 100));
+}
+
+//Copies start their row numbers at zero again, moves keep them
+void copy_and_move()
+{
+	mvg::basic_chunked_container<4, int, std::string> t;
+	for (int i = 0; i < 10; ++i)
+	{
+		t.push_back(std::make_tuple(i, std::to_string(i)));
+	}
+	t.pop_front_block();
+
+	auto const copy = t;
+	MVG_CHECK(copy.size() == 6 && copy.begin().index() == 0);
+	MVG_CHECK(std::get<0>(copy.front()) == 4 && std::get<1>(copy.back()) == "9");
+
+	auto const moved = std::move(t);
+	MVG_CHECK(moved.size() == 6 && moved.begin().index() == 4);
+	MVG_CHECK(std::get<0>(moved.front()) == 4);
+}
+
+} //namespace
+
+int main()
+{
+	pop_front_block();
+	retain();
+	copy_and_move();
+	return mvg_test::check_result();
+}
@@ -0,0 +1,238 @@
+/*The column kernels must compute the same results as plain loops over the rows, for row counts around the vector widths of
+ *the SSE2 and AVX2 paths, so the vectorized loops and the scalar loops handling the leftover rows are both covered.
+ *Floating point values are multiples of 1/4 small enough that all sums and dot products are exact in any order,
+ *so the results are compared exactly*/
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <limits>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "multi_container.hpp"
+#include "column_kernels.hpp"
+
+#include "check.hpp"
+
+namespace
+{
+
+using table = mvg::multi_container<std::vector<int>, std::vector<float>, std::vector<double>, std::vector<std::uint8_t>,
+	std::vector<int>, std::vector<long long>>;
+
+std::size_t const row_counts[] = { 1, 2, 3, 4, 5, 7, 8, 9, 15, 16, 17, 31, 32, 33, 47, 48, 63, 64, 65, 100, 127, 128, 129, 257, 1000, 4099 };
+
+struct generator
+{
+	std::uint64_t state = 0x9E3779B97F4A7C15ull;
+
+	int next(int lo, int hi)
+	{
+		state = state * 6364136223846793005ull + 1442695040888963407ull;
+		return lo + static_cast<int>((state >> 33) % static_cast<std::uint64_t>(hi - lo + 1));
+	}
+};
+
+//Masks are set in runs and at random, and hold other values than 1, so the fully set, empty and mixed blocks
+//of the mask kernels are all used. The int mask has values whose low byte is zero
+table make_table(std::size_t n)
+{
+	generator g;
+	table t;
+	for (std::size_t i = 0; i < n; ++i)
+	{
+		int const run = static_cast<int>(i / 37 % 3);
+		bool const set = run == 0 || (run == 2 && g.next(0, 1) == 1);
+		std::uint8_t const byte_mask = set ? static_cast<std::uint8_t>(g.next(1, 255)) : 0;
+		int const int_mask = set ? (g.next(0, 1) ? 0x100 : -1) : 0;
+		t.push_back(std::make_tuple(g.next(-100000, 100000), g.next(-64, 64) / 4.0f, g.next(-40000, 40000) / 4.0,
+			byte_mask, int_mask, static_cast<long long>(g.next(-100000, 100000)) * (1ll << 20)));
+	}
+	return t;
+}
+
+//The reference loops, with the result types of the kernels
+
+template<std::size_t I>
+auto loop_sum(table const& t)
+{
+	mvg::detail::column_sum_t<std::decay_t<decltype(std::get<I>(t.front()))>> sum {};
+	for (auto const& row : t)
+	{
+		sum += std::get<I>(row);
+	}
+	return sum;
+}
+
+template<std::size_t I>
+auto loop_min_max(table const& t)
+{
+	auto lo = std::get<I>(t.front());
+	auto hi = lo;
+	for (auto const& row : t)
+	{
+		if (std::get<I>(row) < lo)
+		{
+			lo = std::get<I>(row);
+		}
+		if (hi < std::get<I>(row))
+		{
+			hi = std::get<I>(row);
+		}
+	}
+	return std::make_pair(lo, hi);
+}
+
+template<std::size_t I, std::size_t J>
+auto loop_dot(table const& t)
+{
+	decltype(t.dot<I, J>()) dot {};
+	for (auto const& row : t)
+	{
+		dot += std::get<I>(row) * static_cast<decltype(dot)>(std::get<J>(row));
+	}
+	return dot;
+}
+
+template<std::size_t I, std::size_t M>
+void check_masked_select(table const& t)
+{
+	using T = std::decay_t<decltype(std::get<I>(t.front()))>;
+	std::vector<T> expected;
+	for (auto const& row : t)
+	{
+		if (std::get<M>(row))
+		{
+			expected.push_back(std::get<I>(row));
+		}
+	}
+	std::vector<T> selected(t.size() + 1);
+	auto const last = t.masked_select<I, M>(selected.begin());
+	MVG_CHECK(static_cast<std::size_t>(last - selected.begin()) == expected.size());
+	selected.resize(static_cast<std::size_t>(last - selected.begin()));
+	MVG_CHECK(selected == expected);
+
+	std::vector<T> inserted;
+	t.masked_select<I, M>(std::back_inserter(inserted));
+	MVG_CHECK(inserted == expected);
+}
+
+template<std::size_t I>
+bool same_min_max(table const& t)
+{
+	auto const kernel = t.min_max<I>();
+	auto const loop = loop_min_max<I>(t);
+	return kernel == loop;
+}
+
+void kernels(std::size_t n)
+{
+	table const t = make_table(n);
+
+	MVG_CHECK(t.sum<0>() == loop_sum<0>(t));
+	MVG_CHECK(t.sum<1>() == loop_sum<1>(t));
+	MVG_CHECK(t.sum<2>() == loop_sum<2>(t));
+	MVG_CHECK(t.sum<3>() == loop_sum<3>(t));
+	MVG_CHECK(t.sum<5>() == loop_sum<5>(t));
+
+	MVG_CHECK(same_min_max<0>(t));
+	MVG_CHECK(same_min_max<1>(t));
+	MVG_CHECK(same_min_max<2>(t));
+	MVG_CHECK(same_min_max<3>(t));
+	MVG_CHECK(same_min_max<5>(t));
+
+	MVG_CHECK(t.dot<0, 4>() == loop_dot<0, 4>(t));
+	MVG_CHECK(t.dot<1, 1>() == loop_dot<1, 1>(t));
+	MVG_CHECK(t.dot<2, 2>() == loop_dot<2, 2>(t));
+	MVG_CHECK(t.dot<1, 2>() == loop_dot<1, 2>(t));
+
+	check_masked_select<0, 3>(t);
+	check_masked_select<1, 3>(t);
+	check_masked_select<2, 3>(t);
+	check_masked_select<0, 4>(t);
+	check_masked_select<2, 4>(t);
+	check_masked_select<5, 4>(t);
+}
+
+//NaNs are skipped by min_max, unless the first value is NaN, which makes both results NaN
+void min_max_nan()
+{
+	float const nan = std::numeric_limits<float>::quiet_NaN();
+	for (std::size_t n : row_counts)
+	{
+		table t = make_table(n);
+		for (std::size_t i = 1; i < n; i += 3)
+		{
+			std::get<1>(t[i]) = nan;
+		}
+		auto const skipped = t.min_max<1>();
+		MVG_CHECK(skipped == loop_min_max<1>(t));
+
+		std::get<1>(t[0]) = nan;
+		auto const first_nan = t.min_max<1>();
+		MVG_CHECK(std::isnan(first_nan.first) && std::isnan(first_nan.second));
+	}
+}
+
+//for_each_batch visits every row once and in order, in full batches of W rows and a smaller last batch
+template<std::size_t W>
+void batches(std::size_t n)
+{
+	table t = make_table(n);
+	std::vector<int> visited;
+	std::size_t full = 0;
+	std::size_t partial = 0;
+	t.for_each_batch<W>([&](auto a, auto, auto, auto, auto, auto)
+	{
+		if constexpr (decltype(a)::extent == W)
+		{
+			++full;
+		}
+		else
+		{
+			++partial;
+			MVG_CHECK(a.size() < W);
+		}
+		visited.insert(visited.end(), a.begin(), a.end());
+	});
+	MVG_CHECK(full == n / W);
+	MVG_CHECK(partial == (n % W != 0 ? 1u : 0u));
+	MVG_CHECK(visited == std::get<0>(t.data()));
+
+	//The spans are writable
+	t.for_each_batch<W>([](auto a, auto, auto, auto, auto, auto)
+	{
+		for (std::size_t i = 0; i < a.size(); ++i)
+		{
+			a[i] = -a[i];
+		}
+	});
+	for (std::size_t i = 0; i < n; ++i)
+	{
+		MVG_CHECK(std::get<0>(t[i]) == -visited[i]);
+	}
+}
+
+} //namespace
+
+int main()
+{
+	for (std::size_t n : row_counts)
+	{
+		kernels(n);
+		batches<16>(n);
+		batches<5>(n);
+	}
+	min_max_nan();
+
+	table const empty;
+	MVG_CHECK(empty.sum<0>() == 0);
+	MVG_CHECK(empty.dot<1, 2>() == 0);
+	std::vector<double> none;
+	MVG_CHECK(empty.masked_select<2, 3>(none.begin()) == none.begin());
+	MVG_CHECK_THROWS(empty.min_max<0>(), std::runtime_error);
+	return mvg_test::check_result();
+}
@@ -0,0 +1,254 @@
+/*The hash index of indexed_container must find every row after any change. pop_back() removes a slot with a backward shift
+ *of the rest of its cluster, and growing the table rehashes every slot, so both are run with hashes that put many keys
+ *into the same clusters, including clusters that wrap around the end of the table*/
+#include <algorithm>
+#include <cstddef>
+#include <functional>
+#include <map>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "indexed_container.hpp"
+
+#include "check.hpp"
+
+namespace
+{
+
+//Eight keys per hash value, so equal hashes with different keys are compared with key_equal
+struct clustered_hash
+{
+	std::size_t operator()(int key) const
+	{
+		return static_cast<std::size_t>(key / 8);
+	}
+};
+
+//Every key in one cluster, which wraps around the end of the table
+struct constant_hash
+{
+	std::size_t operator()(int) const
+	{
+		return 12345;
+	}
+};
+
+//Throws for negative keys
+struct throwing_hash
+{
+	std::size_t operator()(int key) const
+	{
+		if (key < 0)
+		{
+			throw std::invalid_argument("negative key");
+		}
+		return std::hash<int> {}(key);
+	}
+};
+
+//Checks that every key of keys is found in the row that holds it, with the right count, and that missing isn't found
+template<typename Table>
+bool index_matches(Table const& t, std::vector<int> const& keys, std::vector<int> const& missing)
+{
+	if (t.size() != keys.size())
+	{
+		return false;
+	}
+	std::map<int, std::size_t> counts;
+	for (int key : keys)
+	{
+		++counts[key];
+	}
+	for (auto const& [key, count] : counts)
+	{
+		std::size_t const row = t.position(key);
+		if (row == Table::npos || keys[row] != key || t.count(key) != count || !t.contains(key) ||
+			std::get<0>(*t.find(key)) != key)
+		{
+			return false;
+		}
+	}
+	for (int key : missing)
+	{
+		if (counts.count(key) == 0 && (t.contains(key) || t.count(key) != 0 || t.find(key) != t.end() || t.position(key) != Table::npos))
+		{
+			return false;
+		}
+	}
+	for (std::size_t row = 0; row < keys.size(); ++row)
+	{
+		if (std::get<0>(t.at(row)) != keys[row])
+		{
+			return false;
+		}
+	}
+	return true;
+}
+
+//Keys in a scrambled order, every fifth one twice
+std::vector<int> make_keys(int n)
+{
+	std::vector<int> keys;
+	for (int i = 0; i < n; ++i)
+	{
+		int const key = static_cast<int>((static_cast<unsigned>(i) * 2654435761u) % 1000u);
+		keys.push_back(key);
+		if (i % 5 == 0)
+		{
+			keys.push_back(key);
+		}
+	}
+	return keys;
+}
+
+std::vector<int> const missing = { -1, 1000, 1001, 5000, 7, 8, 9 };
+
+//Appending grows the table from 16 slots on, every growth rehashes all slots
+template<typename Hash>
+void rehash()
+{
+	mvg::basic_indexed_container<0, Hash, std::equal_to<int>, std::vector<int>, std::vector<std::string>> t;
+	std::vector<int> const keys = make_keys(300);
+	std::vector<int> added;
+	for (int key : keys)
+	{
+		t.push_back(std::make_tuple(key, std::to_string(key)));
+		added.push_back(key);
+		MVG_CHECK(index_matches(t, added, missing));
+	}
+
+	//reserve() rehashes a filled table as well
+	t.reserve(4000);
+	MVG_CHECK(index_matches(t, added, missing));
+
+	t.clear();
+	MVG_CHECK(index_matches(t, {}, keys));
+	t.emplace_back(std::forward_as_tuple(5), std::forward_as_tuple("5"));
+	MVG_CHECK(index_matches(t, { 5 }, missing));
+}
+
+//pop_back() in every fill level, so the removed slot is at the start, in the middle and at the end of its cluster
+template<typename Hash>
+void backward_shift()
+{
+	mvg::basic_indexed_container<0, Hash, std::equal_to<int>, std::vector<int>, std::vector<std::string>> t;
+	std::vector<int> keys = make_keys(200);
+	for (int key : keys)
+	{
+		t.push_back(std::make_tuple(key, std::to_string(key)));
+	}
+
+	//Alternates removing and adding rows, so freed slots are reused
+	for (int round = 0; round < 60; ++round)
+	{
+		t.pop_back();
+		keys.pop_back();
+		t.pop_back();
+		keys.pop_back();
+		int const key = 2000 + round;
+		t.push_back(std::make_tuple(key, std::to_string(key)));
+		keys.push_back(key);
+		MVG_CHECK(index_matches(t, keys, missing));
+	}
+
+	while (!keys.empty())
+	{
+		int const removed = keys.back();
+		t.pop_back();
+		keys.pop_back();
+		MVG_CHECK(index_matches(t, keys, missing));
+		MVG_CHECK(std::count(keys.begin(), keys.end(), removed) == static_cast<std::ptrdiff_t>(t.count(removed)));
+	}
+	MVG_CHECK(t.empty());
+}
+
+//Modifiers that move rows rebuild the index
+void rebuild()
+{
+	mvg::basic_indexed_container<0, clustered_hash, std::equal_to<int>, std::vector<int>, std::vector<double>> t;
+	std::vector<int> keys = make_keys(100);
+	for (int key : keys)
+	{
+		t.push_back(std::make_tuple(key, key * 0.5));
+	}
+
+	t.erase(t.begin() + 3);
+	keys.erase(keys.begin() + 3);
+	MVG_CHECK(index_matches(t, keys, missing));
+
+	t.erase(t.begin() + 10, t.begin() + 30);
+	keys.erase(keys.begin() + 10, keys.begin() + 30);
+	MVG_CHECK(index_matches(t, keys, missing));
+
+	t.insert(t.begin() + 5, std::make_tuple(3000, 1500.0));
+	keys.insert(keys.begin() + 5, 3000);
+	MVG_CHECK(index_matches(t, keys, missing));
+
+	t.sort_by<0>();
+	std::stable_sort(keys.begin(), keys.end());
+	MVG_CHECK(index_matches(t, keys, missing));
+
+	t.sort_by<1>(std::greater<> {});
+	std::stable_sort(keys.begin(), keys.end(), std::greater<> {});
+	MVG_CHECK(index_matches(t, keys, missing));
+
+	t.radix_sort_by<0>();
+	std::stable_sort(keys.begin(), keys.end());
+	MVG_CHECK(index_matches(t, keys, missing));
+
+	MVG_CHECK(t.remove_if_rows([](auto const& row) { return std::get<0>(row) % 3 == 0; }) > 0);
+	keys.erase(std::remove_if(keys.begin(), keys.end(), [](int key) { return key % 3 == 0; }), keys.end());
+	MVG_CHECK(index_matches(t, keys, missing));
+
+	t.modify([](auto& c) { std::get<0>(c.data()).front() = 4000; });
+	keys.front() = 4000;
+	MVG_CHECK(index_matches(t, keys, missing));
+
+	//The index is rebuilt when modify() throws as well
+	MVG_CHECK_THROWS(t.modify([](auto& c)
+	{
+		std::get<0>(c.data()).back() = 4001;
+		throw std::runtime_error("modify");
+	}), std::runtime_error);
+	keys.back() = 4001;
+	MVG_CHECK(index_matches(t, keys, missing));
+}
+
+//A throwing hash leaves the row out of the container and the index
+void hash_throws()
+{
+	mvg::basic_indexed_container<0, throwing_hash, std::equal_to<int>, std::vector<int>, std::vector<std::string>> t;
+	std::vector<int> keys;
+	for (int key = 0; key < 40; ++key)
+	{
+		t.push_back(std::make_tuple(key, std::to_string(key)));
+		keys.push_back(key);
+	}
+	MVG_CHECK_THROWS(t.push_back(std::make_tuple(-1, std::string("-1"))), std::invalid_argument);
+	MVG_CHECK_THROWS(t.emplace_back(std::forward_as_tuple(-2), std::forward_as_tuple("-2")), std::invalid_argument);
+	MVG_CHECK(std::get<1>(t.container().data()).size() == keys.size());
+	MVG_CHECK(index_matches(t, keys, { 40, 41 }));
+}
+
+} //namespace
+
+int main()
+{
+	rehash<clustered_hash>();
+	rehash<constant_hash>();
+	rehash<std::hash<int>>();
+	backward_shift<clustered_hash>();
+	backward_shift<constant_hash>();
+	backward_shift<std::hash<int>>();
+	rebuild();
+	hash_throws();
+
+	//indexed_container uses std::hash and std::equal_to
+	mvg::indexed_container<1, std::vector<int>, std::vector<std::string>> names;
+	names.push_back(std::make_tuple(1, std::string("one")));
+	names.push_back(std::make_tuple(2, std::string("two")));
+	MVG_CHECK(names.position("two") == 1);
+	MVG_CHECK(!names.contains("three"));
+	return mvg_test::check_result();
+}
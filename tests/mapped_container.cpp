@@ -0,0 +1,205 @@
+/*load_mmap must map files written by save() with the same column types, and reject with std::runtime_error any file it
+ *can't use in place: another amount of columns, other column types, a corrupted header and truncated files*/
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "multi_container.hpp"
+#include "multi_vector.hpp"
+#include "mapped_container.hpp"
+
+#include "check.hpp"
+
+namespace
+{
+
+struct point
+{
+	float x;
+	float y;
+};
+
+//Same size and alignment as point, but another type
+struct extent
+{
+	float width;
+	float height;
+};
+
+} //namespace
+
+template<>
+struct mvg::column_type_id<point> : std::integral_constant<std::uint64_t, 0x706F696E74> {};
+
+template<>
+struct mvg::column_type_id<extent> : std::integral_constant<std::uint64_t, 0x657874656E74> {};
+
+namespace
+{
+
+using table = mvg::multi_container<std::vector<int>, std::vector<double>, std::vector<std::uint8_t>>;
+
+std::filesystem::path const path = std::filesystem::temp_directory_path() / "mvg_test_mapped_container.bin";
+
+table make_table(int n)
+{
+	table t;
+	for (int i = 0; i < n; ++i)
+	{
+		t.push_back(std::make_tuple(i - 500, i * 0.25, static_cast<std::uint8_t>(i)));
+	}
+	return t;
+}
+
+std::vector<char> read_file()
+{
+	std::ifstream in(path, std::ios::binary);
+	return std::vector<char>(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+}
+
+void write_file(std::vector<char> const& bytes)
+{
+	std::ofstream out(path, std::ios::binary | std::ios::trunc);
+	out.write(bytes.data(), static_cast<std::streamsize>(bytes.size()));
+}
+
+//Saves a table of n rows, lets edit change its bytes and checks that it can't be loaded anymore
+template<typename Edit>
+void check_rejected(int n, Edit edit)
+{
+	make_table(n).save(path);
+	std::vector<char> bytes = read_file();
+	edit(bytes);
+	write_file(bytes);
+	MVG_CHECK_THROWS((mvg::load_mmap<int, double, std::uint8_t>(path)), std::runtime_error);
+}
+
+template<typename T>
+void poke(std::vector<char>& bytes, std::size_t offset, T value)
+{
+	std::memcpy(bytes.data() + offset, &value, sizeof(T));
+}
+
+std::size_t const header_bytes = sizeof(mvg::detail::column_file_header);
+std::size_t const column_bytes = sizeof(mvg::detail::column_file_column);
+
+void round_trip()
+{
+	table const t = make_table(1000);
+	t.save(path);
+	//Every mapping is closed before the file is written again, which Windows requires
+	{
+		auto const m = mvg::load_mmap<int, double, std::uint8_t>(path);
+		MVG_CHECK(m.size() == t.size());
+		MVG_CHECK(std::equal(m.begin(), m.end(), t.begin(), t.end(), [](auto const& a, auto const& b)
+		{
+			return std::get<0>(a) == std::get<0>(b) && std::get<1>(a) == std::get<1>(b) && std::get<2>(a) == std::get<2>(b);
+		}));
+		MVG_CHECK(reinterpret_cast<std::uintptr_t>(m.data<1>()) % mvg::detail::column_file_alignment == 0);
+	}
+
+	//A moved from mapped_container is empty
+	{
+		auto moved = mvg::load_mmap<int, double, std::uint8_t>(path);
+		auto const target = std::move(moved);
+		MVG_CHECK(target.size() == 1000 && std::get<0>(target.back()) == 499);
+		MVG_CHECK(moved.empty() && moved.begin() == moved.end());
+		moved = mvg::load_mmap<int, double, std::uint8_t>(path);
+		MVG_CHECK(moved.size() == 1000);
+	}
+
+	table().save(path);
+	MVG_CHECK(mvg::load_mmap<int, double, std::uint8_t>(path).empty());
+
+	mvg::multi_vector<point, std::int64_t> v;
+	v.push_back(std::make_tuple(point { 1, 2 }, std::int64_t(-3)));
+	v.save(path);
+	{
+		auto const points = mvg::load_mmap<point, std::int64_t>(path);
+		MVG_CHECK(points.size() == 1);
+		MVG_CHECK(std::get<0>(points[0]).y == 2 && std::get<1>(points[0]) == -3);
+	}
+}
+
+void other_columns()
+{
+	make_table(10).save(path);
+	MVG_CHECK_THROWS((mvg::load_mmap<int, double>(path)), std::runtime_error);
+	MVG_CHECK_THROWS((mvg::load_mmap<int, double, std::uint8_t, int>(path)), std::runtime_error);
+	MVG_CHECK_THROWS((mvg::load_mmap<unsigned, double, std::uint8_t>(path)), std::runtime_error);
+	MVG_CHECK_THROWS((mvg::load_mmap<float, double, std::uint8_t>(path)), std::runtime_error);
+	MVG_CHECK_THROWS((mvg::load_mmap<int, float, std::uint8_t>(path)), std::runtime_error);
+	MVG_CHECK_THROWS((mvg::load_mmap<int, std::int64_t, std::uint8_t>(path)), std::runtime_error);
+	MVG_CHECK_THROWS((mvg::load_mmap<int, double, std::int8_t>(path)), std::runtime_error);
+	MVG_CHECK_THROWS((mvg::load_mmap<int, double, bool>(path)), std::runtime_error);
+	MVG_CHECK_THROWS((mvg::load_mmap<double, int, std::uint8_t>(path)), std::runtime_error);
+
+	//Types of the same size and alignment are told apart by their column_type_id
+	mvg::multi_container<std::vector<point>> points;
+	points.push_back(std::make_tuple(point { 1, 2 }));
+	points.save(path);
+	MVG_CHECK(mvg::load_mmap<point>(path).size() == 1);
+	MVG_CHECK_THROWS(mvg::load_mmap<extent>(path), std::runtime_error);
+	MVG_CHECK_THROWS(mvg::load_mmap<std::uint64_t>(path), std::runtime_error);
+	MVG_CHECK_THROWS(mvg::load_mmap<double>(path), std::runtime_error);
+}
+
+void corrupted_header()
+{
+	check_rejected(10, [](std::vector<char>& bytes) { bytes[0] = 'X'; });
+	check_rejected(10, [](std::vector<char>& bytes) { poke(bytes, offsetof(mvg::detail::column_file_header, version), std::uint32_t(1)); });
+	check_rejected(10, [](std::vector<char>& bytes) { poke(bytes, offsetof(mvg::detail::column_file_header, endian), std::uint32_t(0x04030201)); });
+	check_rejected(10, [](std::vector<char>& bytes) { poke(bytes, offsetof(mvg::detail::column_file_header, column_count), std::uint32_t(4)); });
+	check_rejected(10, [](std::vector<char>& bytes) { poke(bytes, offsetof(mvg::detail::column_file_header, row_count), std::uint64_t(11)); });
+	check_rejected(10, [](std::vector<char>& bytes) { poke(bytes, offsetof(mvg::detail::column_file_header, row_count), ~std::uint64_t(0) / 2); });
+
+	std::size_t const second = header_bytes + column_bytes;
+	check_rejected(10, [second](std::vector<char>& bytes)
+	{
+		poke(bytes, second + offsetof(mvg::detail::column_file_column, offset), std::uint64_t(mvg::detail::column_file_alignment + 8));
+	});
+	check_rejected(10, [second](std::vector<char>& bytes)
+	{
+		poke(bytes, second + offsetof(mvg::detail::column_file_column, offset), std::uint64_t(1) << 40);
+	});
+	check_rejected(10, [second](std::vector<char>& bytes)
+	{
+		poke(bytes, second + offsetof(mvg::detail::column_file_column, bytes), std::uint64_t(8 * 9));
+	});
+	check_rejected(10, [second](std::vector<char>& bytes)
+	{
+		poke(bytes, second + offsetof(mvg::detail::column_file_column, element_size), std::uint64_t(4));
+	});
+}
+
+void truncated()
+{
+	check_rejected(10, [](std::vector<char>& bytes) { bytes.clear(); });
+	check_rejected(10, [](std::vector<char>& bytes) { bytes.resize(header_bytes - 1); });
+	check_rejected(10, [](std::vector<char>& bytes) { bytes.resize(header_bytes + 3 * column_bytes - 1); });
+	check_rejected(1000, [](std::vector<char>& bytes) { bytes.resize(bytes.size() - 1000); });
+	check_rejected(1000, [](std::vector<char>& bytes) { bytes.resize(bytes.size() / 2); });
+
+	std::filesystem::remove(path);
+	MVG_CHECK_THROWS((mvg::load_mmap<int, double, std::uint8_t>(path)), std::runtime_error);
+}
+
+} //namespace
+
+int main()
+{
+	round_trip();
+	other_columns();
+	corrupted_header();
+	truncated();
+	std::filesystem::remove(path);
+	return mvg_test::check_result();
+}
@@ -0,0 +1,244 @@
+/*multi_vector must keep its rows unchanged and leak nothing when an element constructor throws, whether it throws while
+ *constructing a new row or while relocating the rows to a bigger block, and must accept arguments that refer to its own rows*/
+#include <cstddef>
+#include <stdexcept>
+#include <string>
+#include <tuple>
+
+#include "multi_vector.hpp"
+
+#include "check.hpp"
+
+namespace
+{
+
+//Counts its live instances, and throws from its constructors once the countdown reaches zero.
+//Its move constructor can throw, so multi_vector relocates it by copying
+struct thrower
+{
+	static inline int live = 0;
+	static inline int countdown = -1;
+
+	int value;
+
+	explicit thrower(int value) : value(value)
+	{
+		tick();
+		++live;
+	}
+
+	thrower(thrower const& rhs) : value(rhs.value)
+	{
+		tick();
+		++live;
+	}
+
+	thrower(thrower&& rhs) : value(rhs.value)
+	{
+		tick();
+		++live;
+	}
+
+	thrower& operator=(thrower const&) = default;
+	thrower& operator=(thrower&&) = default;
+
+	~thrower()
+	{
+		--live;
+	}
+
+	static void tick()
+	{
+		if (countdown >= 0 && countdown-- == 0)
+		{
+			throw std::runtime_error("thrower");
+		}
+	}
+};
+
+using table = mvg::multi_vector<std::string, thrower, int>;
+
+bool row_intact(table const& t, std::size_t i)
+{
+	auto const row = t[i];
+	return std::get<0>(row) == "row " + std::to_string(i) && std::get<1>(row).value == static_cast<int>(i) &&
+		std::get<2>(row) == static_cast<int>(i);
+}
+
+bool rows_intact(table const& t, std::size_t n)
+{
+	if (t.size() != n)
+	{
+		return false;
+	}
+	for (std::size_t i = 0; i < n; ++i)
+	{
+		if (!row_intact(t, i))
+		{
+			return false;
+		}
+	}
+	return true;
+}
+
+void fill(table& t, std::size_t n)
+{
+	for (std::size_t i = t.size(); i < n; ++i)
+	{
+		t.emplace_back(std::forward_as_tuple("row " + std::to_string(i)), std::forward_as_tuple(static_cast<int>(i)),
+			std::forward_as_tuple(static_cast<int>(i)));
+	}
+}
+
+//The new row throws, with and without room for it
+void throwing_row()
+{
+	{
+		table t;
+		fill(t, 4);
+		t.reserve(8);
+		thrower::countdown = 0;
+		MVG_CHECK_THROWS(t.emplace_back(std::forward_as_tuple("x"), std::forward_as_tuple(99), std::forward_as_tuple(99)),
+			std::runtime_error);
+		thrower::countdown = -1;
+		MVG_CHECK(rows_intact(t, 4));
+		MVG_CHECK(thrower::live == 4);
+	}
+	MVG_CHECK(thrower::live == 0);
+
+	{
+		table t;
+		fill(t, 4);
+		t.shrink_to_fit();
+		thrower::countdown = 0;
+		MVG_CHECK_THROWS(t.emplace_back(std::forward_as_tuple("x"), std::forward_as_tuple(99), std::forward_as_tuple(99)),
+			std::runtime_error);
+		thrower::countdown = -1;
+		MVG_CHECK(rows_intact(t, 4));
+		MVG_CHECK(t.capacity() == 4);
+		MVG_CHECK(thrower::live == 4);
+	}
+	MVG_CHECK(thrower::live == 0);
+}
+
+//Relocating the old rows to a bigger block throws after some of them were copied
+void throwing_relocation()
+{
+	for (int at = 0; at < 8; ++at)
+	{
+		{
+			table t;
+			fill(t, 8);
+			t.shrink_to_fit();
+			thrower::countdown = at;
+			MVG_CHECK_THROWS(t.reserve(16), std::runtime_error);
+			thrower::countdown = -1;
+			MVG_CHECK(rows_intact(t, 8));
+			MVG_CHECK(t.capacity() == 8);
+			MVG_CHECK(thrower::live == 8);
+		}
+		MVG_CHECK(thrower::live == 0);
+	}
+
+	//The new row is constructed first, then the old rows are relocated
+	for (int at = 1; at < 8; ++at)
+	{
+		{
+			table t;
+			fill(t, 8);
+			t.shrink_to_fit();
+			thrower::countdown = at;
+			MVG_CHECK_THROWS(fill(t, 9), std::runtime_error);
+			thrower::countdown = -1;
+			MVG_CHECK(rows_intact(t, 8));
+			MVG_CHECK(thrower::live == 8);
+		}
+		MVG_CHECK(thrower::live == 0);
+	}
+}
+
+//Copying throws part way through
+void throwing_copy()
+{
+	for (int at = 0; at < 6; ++at)
+	{
+		{
+			table t;
+			fill(t, 6);
+			table u;
+			fill(u, 2);
+			thrower::countdown = at;
+			MVG_CHECK_THROWS(table { t }, std::runtime_error);
+			thrower::countdown = at;
+			MVG_CHECK_THROWS(u = t, std::runtime_error);
+			thrower::countdown = -1;
+			MVG_CHECK(rows_intact(t, 6));
+			MVG_CHECK(rows_intact(u, 2));
+			MVG_CHECK(thrower::live == 8);
+		}
+		MVG_CHECK(thrower::live == 0);
+	}
+}
+
+//Arguments referring to rows of the multi_vector itself, which reallocation moves
+void aliasing()
+{
+	{
+		table t;
+		fill(t, 4);
+		t.shrink_to_fit();
+		t.emplace_back(std::forward_as_tuple(t.data<0>()[0]), std::forward_as_tuple(t.data<1>()[1]), std::forward_as_tuple(t.data<2>()[2]));
+		MVG_CHECK(t.size() == 5);
+		MVG_CHECK(t.data<0>()[4] == "row 0");
+		MVG_CHECK(t.data<1>()[4].value == 1);
+		MVG_CHECK(t.data<2>()[4] == 2);
+		MVG_CHECK(row_intact(t, 0) && row_intact(t, 3));
+
+		t.shrink_to_fit();
+		t.push_back(std::tie(t.data<0>()[3], t.data<1>()[3], t.data<2>()[3]));
+		MVG_CHECK(t.size() == 6);
+		MVG_CHECK(t.data<0>()[5] == "row 3");
+		MVG_CHECK(t.data<1>()[5].value == 3);
+
+		t.shrink_to_fit();
+		t.insert(t.begin() + 1, std::tie(t.data<0>()[2], t.data<1>()[2], t.data<2>()[2]));
+		MVG_CHECK(t.size() == 7);
+		MVG_CHECK(t.data<0>()[1] == "row 2");
+		MVG_CHECK(t.data<0>()[2] == "row 1");
+
+		t.shrink_to_fit();
+		t.resize(10, std::tie(t.data<0>()[0], t.data<1>()[0], t.data<2>()[0]));
+		MVG_CHECK(t.size() == 10);
+		for (std::size_t i = 7; i < 10; ++i)
+		{
+			MVG_CHECK(t.data<0>()[i] == "row 0");
+			MVG_CHECK(t.data<1>()[i].value == 0);
+		}
+
+		table const& self = t;
+		t = self;
+		MVG_CHECK(t.size() == 10);
+		MVG_CHECK(t.data<0>()[0] == "row 0");
+	}
+	MVG_CHECK(thrower::live == 0);
+}
+
+void at_out_of_range()
+{
+	table t;
+	fill(t, 3);
+	MVG_CHECK_THROWS(t.at(3), std::out_of_range);
+	MVG_CHECK(std::get<2>(t.at(2)) == 2);
+}
+
+} //namespace
+
+int main()
+{
+	throwing_row();
+	throwing_relocation();
+	throwing_copy();
+	aliasing();
+	at_out_of_range();
+	return mvg_test::check_result();
+}
@@ -0,0 +1,147 @@
+/*radix_sort_by must give the same order as std::stable_sort with operator<, for signed, unsigned and floating point keys.
+ *Floating point keys include -0.0, which keeps its order with +0.0, and NaNs, which go after +infinity in their order*/
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <deque>
+#include <limits>
+#include <numeric>
+#include <vector>
+
+#include "multi_container.hpp"
+
+#include "check.hpp"
+
+namespace
+{
+
+//operator< with all NaNs after every other value, the order radix_sort_by documents
+template<typename K>
+bool key_less(K a, K b)
+{
+	if constexpr (std::is_floating_point_v<K>)
+	{
+		if (std::isnan(a) || std::isnan(b))
+		{
+			return !std::isnan(a) && std::isnan(b);
+		}
+	}
+	return a < b;
+}
+
+//Sorts the keys with radix_sort_by<0>() next to their original row numbers, and checks the rows against std::stable_sort
+template<typename K, template<typename...> class Column = std::vector>
+void check_sort(std::vector<K> const& keys)
+{
+	mvg::multi_container<Column<K>, std::vector<std::size_t>> c;
+	for (std::size_t i = 0; i < keys.size(); ++i)
+	{
+		c.push_back(std::make_tuple(keys[i], i));
+	}
+	c.template radix_sort_by<0>();
+
+	std::vector<std::size_t> expected(keys.size());
+	std::iota(expected.begin(), expected.end(), std::size_t(0));
+	std::stable_sort(expected.begin(), expected.end(), [&keys](std::size_t a, std::size_t b) { return key_less(keys[a], keys[b]); });
+
+	MVG_CHECK(c.size() == keys.size());
+	std::size_t i = 0;
+	for (auto const& row : c)
+	{
+		MVG_CHECK(std::get<1>(row) == expected[i]);
+		//Compares the bits, so that -0.0 and NaN are told apart as well
+		K const key = std::get<0>(row);
+		MVG_CHECK(std::memcmp(&key, &keys[expected[i]], sizeof(K)) == 0);
+		++i;
+	}
+}
+
+//Pseudo random keys with many duplicates, so stability matters
+template<typename K>
+std::vector<K> random_keys(std::size_t n, long long lo, long long hi)
+{
+	std::vector<K> keys;
+	std::uint64_t state = 0x243F6A8885A308D3ull;
+	for (std::size_t i = 0; i < n; ++i)
+	{
+		state = state * 6364136223846793005ull + 1442695040888963407ull;
+		long long const range = hi - lo + 1;
+		keys.push_back(static_cast<K>(lo + static_cast<long long>((state >> 33) % static_cast<std::uint64_t>(range))));
+	}
+	return keys;
+}
+
+void signed_keys()
+{
+	check_sort(random_keys<int>(5000, -50, 50));
+	check_sort(random_keys<std::int8_t>(1000, -128, 127));
+	check_sort(random_keys<std::int64_t>(3000, -1000000, 1000000));
+	check_sort<int, std::deque>(random_keys<int>(2000, -20, 20));
+
+	check_sort(std::vector<int> { 0, -1, std::numeric_limits<int>::max(), std::numeric_limits<int>::min(), 1, -1, 0,
+		std::numeric_limits<int>::min() });
+	check_sort(std::vector<std::int64_t> { std::numeric_limits<std::int64_t>::min(), -1, 0, std::numeric_limits<std::int64_t>::max(), -1 });
+}
+
+void unsigned_keys()
+{
+	check_sort(random_keys<unsigned>(5000, 0, 100));
+	check_sort(random_keys<std::uint16_t>(2000, 0, 65535));
+	check_sort(std::vector<std::uint64_t> { std::numeric_limits<std::uint64_t>::max(), 0, 1, std::uint64_t(1) << 63, 0 });
+	check_sort(random_keys<std::uint8_t>(1000, 0, 3));
+}
+
+template<typename F>
+void float_keys()
+{
+	constexpr F inf = std::numeric_limits<F>::infinity();
+	constexpr F nan = std::numeric_limits<F>::quiet_NaN();
+	F const negative_nan = std::copysign(nan, F(-1));
+
+	check_sort(std::vector<F> { F(1.5), F(-0.0), F(0.0), F(-2), nan, inf, F(0.0), -inf, negative_nan, F(-0.0), F(-1.5),
+		std::numeric_limits<F>::denorm_min(), -std::numeric_limits<F>::denorm_min(), std::numeric_limits<F>::lowest(), nan });
+
+	std::vector<F> keys = random_keys<F>(4000, -100, 100);
+	for (std::size_t i = 0; i < keys.size(); i += 7)
+	{
+		keys[i] /= F(8);
+	}
+	for (std::size_t i = 3; i < keys.size(); i += 97)
+	{
+		keys[i] = i % 2 ? F(-0.0) : nan;
+	}
+	check_sort(keys);
+}
+
+//Sorting by the less significant key first, then by the more significant one, sorts by both
+void multiple_keys()
+{
+	mvg::multi_container<std::vector<int>, std::vector<double>> c;
+	std::vector<int> const major = random_keys<int>(2000, -10, 10);
+	std::vector<double> const minor = random_keys<double>(2000, -30, 30);
+	for (std::size_t i = 0; i < major.size(); ++i)
+	{
+		c.push_back(std::make_tuple(major[i], minor[i]));
+	}
+	c.radix_sort_by<1>();
+	c.radix_sort_by<0>();
+	MVG_CHECK(std::is_sorted(c.begin(), c.end(), [](auto const& a, auto const& b)
+	{
+		return std::make_pair(std::get<0>(a), std::get<1>(a)) < std::make_pair(std::get<0>(b), std::get<1>(b));
+	}));
+}
+
+} //namespace
+
+int main()
+{
+	signed_keys();
+	unsigned_keys();
+	float_keys<float>();
+	float_keys<double>();
+	multiple_keys();
+	check_sort(std::vector<int> {});
+	return mvg_test::check_result();
+}
@@ -0,0 +1,97 @@
+/*remove_if_rows compacts every column on its own, so after it every column must still hold the kept rows in their order,
+ *with vector, deque and list columns and trivially copyable, copyable and move only elements*/
+#include <cstddef>
+#include <deque>
+#include <iterator>
+#include <list>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "multi_container.hpp"
+
+#include "check.hpp"
+
+namespace
+{
+
+using table = mvg::multi_container<std::vector<int>, std::deque<std::string>, std::list<double>, std::vector<std::unique_ptr<int>>>;
+
+table make_table(int n)
+{
+	table t;
+	for (int i = 0; i < n; ++i)
+	{
+		t.push_back(std::make_tuple(i, std::to_string(i), i * 0.5, std::make_unique<int>(i)));
+	}
+	return t;
+}
+
+//Removes the rows for which remove(i) is true from a table of n rows, and checks that every column holds the other rows
+template<typename Remove>
+void check_remove(int n, Remove remove)
+{
+	table t = make_table(n);
+	std::vector<int> expected;
+	for (int i = 0; i < n; ++i)
+	{
+		if (!remove(i))
+		{
+			expected.push_back(i);
+		}
+	}
+
+	std::size_t calls = 0;
+	std::size_t const removed = t.remove_if_rows([&](auto const& row)
+	{
+		++calls;
+		return remove(std::get<0>(row));
+	});
+	MVG_CHECK(calls == static_cast<std::size_t>(n));
+	MVG_CHECK(removed == static_cast<std::size_t>(n) - expected.size());
+	MVG_CHECK(t.size() == expected.size());
+	MVG_CHECK(std::get<1>(t.data()).size() == expected.size());
+	MVG_CHECK(std::get<2>(t.data()).size() == expected.size());
+	MVG_CHECK(std::get<3>(t.data()).size() == expected.size());
+
+	std::size_t k = 0;
+	for (auto const& row : t)
+	{
+		int const i = expected[k];
+		MVG_CHECK(std::get<0>(row) == i);
+		MVG_CHECK(std::get<1>(row) == std::to_string(i));
+		MVG_CHECK(std::get<2>(row) == i * 0.5);
+		MVG_CHECK(std::get<3>(row) && *std::get<3>(row) == i);
+		++k;
+	}
+	MVG_CHECK(k == expected.size());
+}
+
+} //namespace
+
+int main()
+{
+	for (int n : { 0, 1, 2, 17, 100 })
+	{
+		check_remove(n, [](int) { return false; });
+		check_remove(n, [](int) { return true; });
+		check_remove(n, [](int i) { return i == 0; });
+		check_remove(n, [n](int i) { return i == n - 1; });
+		check_remove(n, [](int i) { return i % 2 == 0; });
+		check_remove(n, [](int i) { return i % 3 != 0; });
+		check_remove(n, [](int i) { return i >= 5 && i < 40; });
+		check_remove(n, [](int i) { return (i * 2654435761u >> 7) % 5 < 2; });
+	}
+
+	//The table stays usable after compaction
+	table t = make_table(10);
+	t.remove_if_rows([](auto const& row) { return std::get<0>(row) < 5; });
+	t.push_back(std::make_tuple(10, std::string("10"), 5.0, std::make_unique<int>(10)));
+	MVG_CHECK(t.size() == 6);
+	MVG_CHECK(std::get<0>(t.front()) == 5);
+	//back() needs random access, which the list column doesn't have
+	auto const last = std::prev(t.end());
+	MVG_CHECK(std::get<1>(*last) == "10");
+	MVG_CHECK(*std::get<3>(*last) == 10);
+	return mvg_test::check_result();
+}
@@ -0,0 +1,190 @@
+/*sorted_index must return the rows in key order, rows with equal keys in row order, after every change: rows appended
+ *between queries are sorted on their own and merged into the permutation, other changes rebuild it. range(lo, hi)
+ *includes both bounds*/
+#include <algorithm>
+#include <cstddef>
+#include <functional>
+#include <numeric>
+#include <string>
+#include <vector>
+
+#include "multi_container.hpp"
+#include "multi_vector.hpp"
+#include "sorted_index.hpp"
+
+#include "check.hpp"
+
+namespace
+{
+
+using table = mvg::multi_container<std::vector<int>, std::vector<std::string>>;
+
+void append(table& t, std::vector<int> const& keys)
+{
+	for (int key : keys)
+	{
+		t.push_back(std::make_tuple(key, std::to_string(t.size())));
+	}
+}
+
+//Row numbers of the rows of t in the expected order: by key with comp, equal keys in row order
+template<typename Compare = std::less<>>
+std::vector<std::size_t> expected_order(table const& t, Compare comp = Compare {})
+{
+	auto const& keys = std::get<0>(t.data());
+	std::vector<std::size_t> order(keys.size());
+	std::iota(order.begin(), order.end(), std::size_t(0));
+	std::stable_sort(order.begin(), order.end(), [&](std::size_t a, std::size_t b) { return comp(keys[a], keys[b]); });
+	return order;
+}
+
+//Row numbers of the rows of a view, taken from their row number column
+template<typename View>
+std::vector<std::size_t> rows_of(View const& view)
+{
+	std::vector<std::size_t> rows;
+	for (auto const& row : view)
+	{
+		rows.push_back(std::stoul(std::get<1>(row)));
+	}
+	return rows;
+}
+
+//Row numbers of the rows whose key lies in [lo, hi], in the expected order
+std::vector<std::size_t> expected_range(table const& t, int lo, int hi)
+{
+	std::vector<std::size_t> rows;
+	for (std::size_t row : expected_order(t))
+	{
+		int const key = std::get<0>(t.data())[row];
+		if (lo <= key && key <= hi)
+		{
+			rows.push_back(row);
+		}
+	}
+	return rows;
+}
+
+void merge()
+{
+	table t;
+	mvg::sorted_index<0, table> index(t);
+	MVG_CHECK(index.all().empty());
+
+	append(t, { 5, 3, 9, 3, 7 });
+	MVG_CHECK(index.order() == expected_order(t));
+
+	//Appended keys below, above, between and equal to the indexed ones, with duplicates among themselves
+	append(t, { 1, 10, 3, 6, 5, 3, 0 });
+	MVG_CHECK(index.order() == expected_order(t));
+	MVG_CHECK(rows_of(index.all()) == expected_order(t));
+
+	//Several appends between two queries are merged at once
+	append(t, { 4 });
+	append(t, { 4, 11, -1 });
+	append(t, { 3 });
+	MVG_CHECK(index.order() == expected_order(t));
+
+	//Many small merges
+	for (int i = 0; i < 200; ++i)
+	{
+		append(t, { (i * 37) % 23 - 5 });
+		if (i % 7 == 0)
+		{
+			MVG_CHECK(index.order() == expected_order(t));
+		}
+	}
+	MVG_CHECK(index.order() == expected_order(t));
+	MVG_CHECK(index.all().size() == t.size());
+
+	//Rows removed without invalidate() are noticed by the smaller size
+	t.erase(t.begin() + 10, t.end());
+	MVG_CHECK(index.order() == expected_order(t));
+
+	//Other changes need invalidate()
+	t.sort_by<1>();
+	index.invalidate();
+	MVG_CHECK(index.order() == expected_order(t));
+	std::get<0>(t[2]) = 100;
+	index.invalidate();
+	MVG_CHECK(index.order() == expected_order(t));
+	append(t, { 50 });
+	MVG_CHECK(index.order() == expected_order(t));
+}
+
+void range_bounds()
+{
+	table t;
+	append(t, { 4, 8, 2, 8, 6, 2, 10, 4, 8 });
+	mvg::sorted_index<0, table> index(t);
+
+	int const bounds[] = { -5, 1, 2, 3, 4, 5, 8, 9, 10, 11, 20 };
+	for (int lo : bounds)
+	{
+		for (int hi : bounds)
+		{
+			auto const view = index.range(lo, hi);
+			std::vector<std::size_t> const expected = expected_range(t, lo, hi);
+			MVG_CHECK(view.size() == expected.size());
+			MVG_CHECK(rows_of(view) == expected);
+			MVG_CHECK(view.empty() == (lo > hi || expected.empty()));
+		}
+	}
+
+	auto const eights = index.equal_range(8);
+	MVG_CHECK(rows_of(eights) == (std::vector<std::size_t> { 1, 3, 8 }));
+	MVG_CHECK(std::get<0>(eights.front()) == 8 && std::get<0>(eights.back()) == 8 && std::get<1>(eights[1]) == "3");
+	MVG_CHECK(index.equal_range(5).empty());
+	MVG_CHECK(index.equal_range(-1).empty());
+	MVG_CHECK(index.equal_range(11).empty());
+
+	//Appended rows show up in the next query
+	append(t, { 8, 5 });
+	MVG_CHECK(rows_of(index.equal_range(8)) == (std::vector<std::size_t> { 1, 3, 8, 9 }));
+	MVG_CHECK(rows_of(index.range(5, 6)) == (std::vector<std::size_t> { 10, 4 }));
+}
+
+//With std::greater the keys are in descending order, and range(lo, hi) needs lo >= hi
+void descending()
+{
+	table t;
+	append(t, { 4, 8, 2, 8, 6 });
+	mvg::sorted_index<0, table, std::greater<>> index(t);
+	MVG_CHECK(index.order() == expected_order(t, std::greater<> {}));
+	append(t, { 7, 1, 8 });
+	MVG_CHECK(index.order() == expected_order(t, std::greater<> {}));
+	MVG_CHECK(rows_of(index.range(8, 6)) == (std::vector<std::size_t> { 1, 3, 7, 5, 4 }));
+	MVG_CHECK(index.range(6, 8).empty());
+}
+
+void over_multi_vector()
+{
+	mvg::multi_vector<double, int> v;
+	mvg::sorted_index<0, mvg::multi_vector<double, int>> index(v);
+	double const keys[] = { 0.5, -1.0, 2.0, 0.5, 1.5 };
+	for (int i = 0; i < 5; ++i)
+	{
+		v.push_back(std::make_tuple(keys[i], i));
+	}
+	MVG_CHECK(index.order() == (std::vector<std::size_t> { 1, 0, 3, 4, 2 }));
+	v.push_back(std::make_tuple(0.5, 5));
+	auto const view = index.range(0.5, 1.5);
+	MVG_CHECK(view.size() == 4);
+	std::vector<int> rows;
+	for (auto const& row : view)
+	{
+		rows.push_back(std::get<1>(row));
+	}
+	MVG_CHECK(rows == (std::vector<int> { 0, 3, 5, 4 }));
+}
+
+} //namespace
+
+int main()
+{
+	merge();
+	range_bounds();
+	descending();
+	over_multi_vector();
+	return mvg_test::check_result();
+}